@@ -0,0 +1,23 @@
+// nary_operator.hpp
+
+#ifndef NARY_OPERATOR_HPP
+#define NARY_OPERATOR_HPP
+
+#include "core/relation.hpp"
+#include <vector>
+
+class NaryOperator {
+public:
+    // The primary interface for operators over any number of input relations
+    SecureRelation execute(const std::vector<SecureRelation>& inputs) {
+        return operation(inputs);
+    }
+
+protected:
+    // Pure virtual function for the actual operation. Subclasses must provide an implementation.
+    virtual SecureRelation operation(const std::vector<SecureRelation>& inputs) = 0;
+
+    virtual ~NaryOperator() {}  // Virtual destructor for proper cleanup
+};
+
+#endif // NARY_OPERATOR_HPP
@@ -0,0 +1,84 @@
+// join_key.hpp
+
+#ifndef JOIN_KEY_HPP
+#define JOIN_KEY_HPP
+
+#include "core/relation.hpp"
+#include <stdexcept>
+#include <vector>
+
+// Join key over one or more columns. Each column takes part with its declared bit width:
+// the low widths[k] bits of column k, which must hold every value of that column (e.g. 16
+// bits for a day number, 8 for a branch code). The key of a row is the concatenation of
+// those bits, so a composite key is compared with a single equality circuit of
+// sum(widths) bits instead of one 32-bit equality per column plus the ANDs between them.
+// Packing only rearranges wires and costs no gates.
+class JoinKey {
+public:
+    std::vector<int> columns;  // Key columns, most significant first
+    std::vector<int> widths;   // Bits of each column that take part in the key
+
+    // Single full-width column; allows passing a plain column index wherever a key is expected
+    JoinKey(int column);
+
+    // Composite key; without widths every column takes part with 32 bits
+    JoinKey(const std::vector<int>& columns, const std::vector<int>& widths = {});
+
+    // Total width of the packed key
+    int width() const;
+
+    // Packed key of every row of rel
+    std::vector<emp::Integer> pack(const SecureRelation& rel) const;
+
+    // Throws unless the two keys pack to the same layout
+    static void check_compatible(const JoinKey& key1, const JoinKey& key2);
+};
+
+// Implementations
+
+JoinKey::JoinKey(int column) : columns(1, column), widths(1, 32) {}
+
+JoinKey::JoinKey(const std::vector<int>& columns, const std::vector<int>& widths)
+    : columns(columns), widths(widths.empty() ? std::vector<int>(columns.size(), 32) : widths) {
+    if (columns.empty() || this->widths.size() != columns.size()) {
+        throw std::invalid_argument("Join key needs one width per key column");
+    }
+    for (int w : this->widths) {
+        if (w < 1 || w > 32) {
+            throw std::invalid_argument("Join key column widths must be between 1 and 32 bits");
+        }
+    }
+}
+
+int JoinKey::width() const {
+    int total = 0;
+    for (int w : widths) total += w;
+    return total;
+}
+
+std::vector<emp::Integer> JoinKey::pack(const SecureRelation& rel) const {
+    int rows = rel.flags.size();
+    if (columns.size() == 1 && widths[0] == 32) {
+        return rel.columns[columns[0]];
+    }
+
+    std::vector<emp::Integer> keys(rows);
+    for (int row = 0; row < rows; row++) {
+        emp::Integer& key = keys[row];
+        key.bits.reserve(width());
+        // Least significant bits first: the last column ends up in the low bits
+        for (int k = columns.size() - 1; k >= 0; k--) {
+            const emp::Integer& value = rel.columns[columns[k]][row];
+            key.bits.insert(key.bits.end(), value.bits.begin(), value.bits.begin() + widths[k]);
+        }
+    }
+    return keys;
+}
+
+void JoinKey::check_compatible(const JoinKey& key1, const JoinKey& key2) {
+    if (key1.widths != key2.widths) {
+        throw std::invalid_argument("Join keys must have the same number of columns and the same widths");
+    }
+}
+
+#endif // JOIN_KEY_HPP
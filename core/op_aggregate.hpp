@@ -0,0 +1,306 @@
+// aggregate_operator.hpp
+
+#ifndef AGGREGATE_OPERATOR_HPP
+#define AGGREGATE_OPERATOR_HPP
+
+#include "_op_unary.hpp"
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <map>
+#include <algorithm>
+#include <utility>
+
+// Scalar aggregate over the real rows of a relation. Every row is first conditioned on its
+// flag (flag ? value : identity of the aggregate), then the values are reduced in a balanced
+// tree, so the circuit is log-depth and the work of a tree level can be split freely.
+// The result is a one-row relation holding the aggregate in column 0. COUNT always has a
+// real result row; SUM, MIN, MAX and AVG of no real rows give a dummy row, like SQL's NULL.
+class AggregateOperator : public UnaryOperator {
+public:
+    enum Function {
+        COUNT,  // Number of real rows, 32 bits
+        SUM,    // Sum of the column, wide enough that it cannot overflow (at most 64 bits)
+        MIN,    // Smallest value of the column, column width
+        MAX,    // Largest value of the column, column width
+        AVG     // Sum divided by count, rounded towards zero, column width
+    };
+
+    Function function;
+    int column_index;  // The aggregated column, unused by COUNT
+    int output_width;  // Width of a SUM, 0 picks it from the row count
+
+    AggregateOperator(Function function, int column_index = 0, int output_width = 0);
+
+    // Value a dummy row contributes: 0 for COUNT, SUM and AVG, the largest value for MIN, the smallest for MAX
+    static emp::Integer identity(Function function, int width);
+
+    // Associative combination of two partial aggregates of the same width
+    static emp::Integer combine(Function function, const emp::Integer& a, const emp::Integer& b);
+
+    // Width of SUM over rows values of value_width bits: output_width, or wide enough not to overflow
+    int sum_width(int rows, int value_width) const;
+
+    // Width of a count of up to rows real rows, ceil(log2(rows + 1)) bits and at least one
+    static int count_width(int rows);
+
+    // Values of several aggregates over the same relation, computed in one pass: the flags are
+    // read once, and the conditioned rows of a column, sums and counts are built once and shared
+    // by every aggregate that needs them. real_result tells whether the result row is real.
+    static std::vector<emp::Integer> evaluate(const std::vector<AggregateOperator>& aggregates, const SecureRelation& relation, emp::Bit& real_result);
+
+protected:
+    SecureRelation operation(const SecureRelation& relation) override;
+};
+
+class SumOperator : public AggregateOperator {
+public:
+    SumOperator(int column_index, int output_width = 0) : AggregateOperator(SUM, column_index, output_width) {}
+};
+
+class MinOperator : public AggregateOperator {
+public:
+    MinOperator(int column_index) : AggregateOperator(MIN, column_index) {}
+};
+
+class MaxOperator : public AggregateOperator {
+public:
+    MaxOperator(int column_index) : AggregateOperator(MAX, column_index) {}
+};
+
+class AvgOperator : public AggregateOperator {
+public:
+    AvgOperator(int column_index) : AggregateOperator(AVG, column_index) {}
+};
+
+// Sum of the values in a tree of additions. Values of one level are extended by one bit
+// (sign or zero extension) before they are added, until width is reached, so small values
+// stay narrow: a sum of n bits costs about 2n AND gates instead of n width-bit additions.
+emp::Integer sum_tree(std::vector<emp::Integer> values, int width, bool is_signed = true);
+
+// Reduction of the values with an associative operator in a balanced tree
+emp::Integer reduce_tree(std::vector<emp::Integer> values, const std::function<emp::Integer(const emp::Integer&, const emp::Integer&)>& op);
+
+// Number of bits set, as an unsigned width-bit Integer
+emp::Integer popcount(const std::vector<emp::Bit>& bits, int width = 32);
+
+// OR of the bits in a tree
+emp::Bit any_bit(std::vector<emp::Bit> bits);
+
+// Definitions
+
+AggregateOperator::AggregateOperator(Function function, int column_index, int output_width)
+    : function(function), column_index(column_index), output_width(output_width) {}
+
+SecureRelation AggregateOperator::operation(const SecureRelation& relation) {
+    emp::Bit real_result;
+    std::vector<emp::Integer> values = evaluate({*this}, relation, real_result);
+
+    SecureRelation result(1, 1);
+    result.columns[0][0] = values[0];
+    result.flags[0] = bit_to_flag(real_result);
+    return result;
+}
+
+std::vector<emp::Integer> AggregateOperator::evaluate(const std::vector<AggregateOperator>& aggregates, const SecureRelation& relation, emp::Bit& real_result) {
+    int rows = relation.flags.size();
+    std::vector<emp::Bit> real(rows);
+    for (int i = 0; i < rows; i++) {
+        real[i] = flag_bit(relation.flags[i]);
+    }
+
+    bool only_counts = true;
+    for (const auto& aggregate : aggregates) {
+        only_counts = only_counts && aggregate.function == COUNT;
+    }
+    real_result = only_counts ? Constants::bit(true) : any_bit(real);
+
+    // Rows of a column conditioned on their flags, by (column, function whose identity dummy rows take)
+    std::map<std::pair<int, int>, std::vector<emp::Integer>> conditioned;
+    auto conditioned_column = [&](int column_index, Function function) -> const std::vector<emp::Integer>& {
+        Function dummy_function = function == MIN || function == MAX ? function : SUM;
+        auto key = std::make_pair(column_index, static_cast<int>(dummy_function));
+        auto it = conditioned.find(key);
+        if (it == conditioned.end()) {
+            const std::vector<emp::Integer>& column = relation.columns[column_index];
+            emp::Integer dummy = identity(dummy_function, column[0].size());
+            std::vector<emp::Integer> values(rows);
+            for (int i = 0; i < rows; i++) {
+                values[i] = emp::If(real[i], column[i], dummy);
+            }
+            it = conditioned.emplace(key, std::move(values)).first;
+        }
+        return it->second;
+    };
+
+    // Sums by (column, width); the count of real rows is one popcount at the widest width any
+    // aggregate asks for, and narrower counts are copies of it resized to their width
+    std::map<std::pair<int, int>, emp::Integer> sums;
+    auto sum_of = [&](int column_index, int width) -> const emp::Integer& {
+        auto key = std::make_pair(column_index, width);
+        auto it = sums.find(key);
+        if (it == sums.end()) {
+            it = sums.emplace(key, sum_tree(conditioned_column(column_index, SUM), width)).first;
+        }
+        return it->second;
+    };
+    int count_width = 0;
+    for (const auto& aggregate : aggregates) {
+        if (aggregate.function == COUNT) {
+            count_width = std::max(count_width, 32);
+        } else if (aggregate.function == AVG && rows > 0) {
+            count_width = std::max(count_width, aggregate.sum_width(rows, relation.columns[aggregate.column_index][0].size()));
+        }
+    }
+    emp::Integer count;
+    if (count_width > 0) {
+        count = popcount(real, count_width);
+    }
+    auto count_of = [&](int width) {
+        emp::Integer resized = count;
+        resized.resize(width, false);
+        return resized;
+    };
+
+    std::vector<emp::Integer> results;
+    for (const auto& aggregate : aggregates) {
+        if (aggregate.function == COUNT) {
+            results.push_back(count_of(32));
+            continue;
+        }
+
+        int column_index = aggregate.column_index;
+        int value_width = rows > 0 ? relation.columns[column_index][0].size() : 32;
+        if (rows == 0) {
+            results.push_back(Constants::zero(aggregate.function == SUM ? aggregate.sum_width(rows, value_width) : value_width));
+            continue;
+        }
+
+        switch (aggregate.function) {
+            case SUM:
+                results.push_back(sum_of(column_index, aggregate.sum_width(rows, value_width)));
+                break;
+            case MIN:
+            case MAX: {
+                Function f = aggregate.function;
+                results.push_back(reduce_tree(conditioned_column(column_index, f),
+                                              [f](const emp::Integer& a, const emp::Integer& b) { return combine(f, a, b); }));
+                break;
+            }
+            case AVG: {
+                // The count is below 2^width of the sum, so it is a positive divisor of the same width
+                int width = aggregate.sum_width(rows, value_width);
+                emp::Integer divisor = emp::If(real_result, count_of(width), emp::Integer(width, 1, emp::PUBLIC));
+                emp::Integer avg = sum_of(column_index, width) / divisor;
+                results.push_back(avg.resize(value_width));
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return results;
+}
+
+emp::Integer AggregateOperator::identity(Function function, int width) {
+    if (function == MIN || function == MAX) {
+        int64_t bound = (int64_t(1) << (width - 1)) - 1;
+        return emp::Integer(width, function == MIN ? bound : -bound - 1, emp::PUBLIC);
+    }
+    return Constants::zero(width);
+}
+
+emp::Integer AggregateOperator::combine(Function function, const emp::Integer& a, const emp::Integer& b) {
+    switch (function) {
+        case MIN:
+            return emp::If(a < b, a, b);
+        case MAX:
+            return emp::If(a < b, b, a);
+        default:
+            return a + b;
+    }
+}
+
+int AggregateOperator::sum_width(int rows, int value_width) const {
+    if (output_width > 0) return output_width;
+    int width = value_width;
+    while (width < Constants::MAX_WIDTH && (int64_t(1) << (width - value_width)) < rows) {
+        width++;
+    }
+    return width;
+}
+
+int AggregateOperator::count_width(int rows) {
+    int width = 1;
+    while (width < Constants::MAX_WIDTH && (int64_t(1) << width) <= rows) {
+        width++;
+    }
+    return width;
+}
+
+emp::Integer sum_tree(std::vector<emp::Integer> values, int width, bool is_signed) {
+    if (values.empty()) {
+        return Constants::zero(width);
+    }
+
+    int level_width = values[0].size();
+    while (values.size() > 1 && level_width < width) {
+        // One more bit per level, so the sum of two values cannot overflow
+        level_width++;
+        std::vector<emp::Integer> next((values.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < values.size(); i += 2) {
+            next[i / 2] = values[i].resize(level_width, is_signed) + values[i + 1].resize(level_width, is_signed);
+        }
+        if (values.size() % 2 == 1) {
+            next.back() = values.back().resize(level_width, is_signed);
+        }
+        values.swap(next);
+    }
+
+    // Sums wider than the output wrap around, like a width-bit accumulator would
+    for (auto& value : values) {
+        value.resize(width, is_signed);
+    }
+    return reduce_tree(values, [](const emp::Integer& a, const emp::Integer& b) { return a + b; });
+}
+
+emp::Integer reduce_tree(std::vector<emp::Integer> values, const std::function<emp::Integer(const emp::Integer&, const emp::Integer&)>& op) {
+    while (values.size() > 1) {
+        std::vector<emp::Integer> next((values.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < values.size(); i += 2) {
+            next[i / 2] = op(values[i], values[i + 1]);
+        }
+        if (values.size() % 2 == 1) {
+            next.back() = values.back();
+        }
+        values.swap(next);
+    }
+    return values[0];
+}
+
+emp::Integer popcount(const std::vector<emp::Bit>& bits, int width) {
+    std::vector<emp::Integer> counts(bits.size());
+    for (size_t i = 0; i < bits.size(); i++) {
+        counts[i].bits.push_back(bits[i]);
+    }
+    return sum_tree(counts, width, false);
+}
+
+emp::Bit any_bit(std::vector<emp::Bit> bits) {
+    if (bits.empty()) {
+        return Constants::bit(false);
+    }
+    while (bits.size() > 1) {
+        std::vector<emp::Bit> next((bits.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < bits.size(); i += 2) {
+            next[i / 2] = bits[i] | bits[i + 1];
+        }
+        if (bits.size() % 2 == 1) {
+            next.back() = bits.back();
+        }
+        bits.swap(next);
+    }
+    return bits[0];
+}
+
+#endif // AGGREGATE_OPERATOR_HPP
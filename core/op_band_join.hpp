@@ -0,0 +1,141 @@
+// band_join.hpp
+
+#ifndef BAND_JOIN_OPERATOR_HPP
+#define BAND_JOIN_OPERATOR_HPP
+
+#include "core/_op_binary.hpp"
+#include "core/synopsis.hpp"
+#include "core/strip_layout.hpp"
+#include "util/public_compare.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+// Band join: a pair (r, s) matches iff lower <= s[column_index2] - r[column_index1] <= upper,
+// e.g. transactions within N days after a loan date. Both relations are sorted on their
+// band columns. Rows of histogram bin i of rel1 hold values in a public range [v, v + w), so
+// their partners lie in [v + lower, v + w - 1 + upper], which the synopsis of rel2 maps to
+// the rows of a few neighbouring bins. Every bucket of rel1 is only compared with those
+// rows, and each bucket result can be compacted to a public bound while it is produced.
+// The noisy ranges of neighbouring buckets overlap on both sides, so every pair of strips
+// is compared by the one bucket owning it (see StripLayout) and no match is emitted twice.
+class BandJoinOperator : public BinaryOperator {
+public:
+    int column_index1;  // The band column index for the first relation
+    int column_index2;  // The band column index for the second relation
+    int64_t lower;  // Inclusive public bounds on column2 - column1
+    int64_t upper;
+    Synopsis synopsis1;  // Noisy CDF index and bin layout of column_index1
+    Synopsis synopsis2;  // Noisy CDF index and bin layout of column_index2
+    int bucket_output_size;  // Rows kept per bucket of rel1, 0 keeps every compared pair
+
+    // Ranges of the buckets in the last result, filled in by execute
+    std::vector<std::pair<int, int>> output_index;
+
+    BandJoinOperator(int col_idx1, int col_idx2, int64_t lower, int64_t upper, const Synopsis& syn1, const Synopsis& syn2, int bucket_output_size = 0);
+
+protected:
+    SecureRelation operation(const SecureRelation& rel1, const SecureRelation& rel2) override;
+
+private:
+    // Rows of rel2 that bucket i of rel1 has to be compared with; first > second when none
+    std::pair<int, int> partner_range(size_t i, int rows2);
+
+    // Band join of the strip pairs owned by bucket i, moved into result from offset on
+    void join_bucket(const SecureRelation& rel1, const SecureRelation& rel2, const StripLayout& layout, size_t i,
+                     int output_size, SecureRelation& result, int offset);
+};
+
+// Definitions
+
+BandJoinOperator::BandJoinOperator(int col_idx1, int col_idx2, int64_t lower, int64_t upper, const Synopsis& syn1, const Synopsis& syn2, int bucket_output_size)
+    : column_index1(col_idx1), column_index2(col_idx2), lower(lower), upper(upper),
+      synopsis1(syn1), synopsis2(syn2), bucket_output_size(bucket_output_size) {}
+
+SecureRelation BandJoinOperator::operation(const SecureRelation& rel1, const SecureRelation& rel2) {
+    int rows1 = rel1.flags.size();
+    int rows2 = rel2.flags.size();
+    size_t buckets = synopsis1.index.size();
+
+    // Public size of every bucket result
+    std::vector<std::pair<int, int>> ranges1(buckets), ranges2(buckets);
+    for (size_t i = 0; i < buckets; i++) {
+        ranges1[i] = std::make_pair(std::max(synopsis1.index[i].first, 0), std::min(synopsis1.index[i].second, rows1 - 1));
+        ranges2[i] = partner_range(i, rows2);
+    }
+    StripLayout layout({ranges1, ranges2});
+
+    std::vector<int> sizes(buckets);
+    output_index.clear();
+    int total_rows = 0;
+    for (size_t i = 0; i < buckets; i++) {
+        long long pairs = 0;
+        for (const auto& cell : layout.cells[i]) {
+            pairs += layout.cell_size(cell);
+        }
+        sizes[i] = bucket_output_size > 0 ? static_cast<int>(std::min<long long>(bucket_output_size, pairs)) : static_cast<int>(pairs);
+
+        output_index.push_back({total_rows, total_rows + sizes[i] - 1});
+        total_rows += sizes[i];
+    }
+
+    SecureRelation result(rel1.columns.size() + rel2.columns.size(), total_rows);
+    for (size_t i = 0; i < buckets; i++) {
+        join_bucket(rel1, rel2, layout, i, sizes[i], result, output_index[i].first);
+    }
+    return result;
+}
+
+std::pair<int, int> BandJoinOperator::partner_range(size_t i, int rows2) {
+    int64_t bin_lower = synopsis1.domain_min + static_cast<int64_t>(i) * synopsis1.bin_width;
+    int64_t bin_upper = bin_lower + synopsis1.bin_width - 1;
+    std::pair<int, int> range = synopsis2.covering_range(bin_lower + lower, bin_upper + upper);
+    return std::make_pair(std::max(range.first, 0), std::min(range.second, rows2 - 1));
+}
+
+void BandJoinOperator::join_bucket(const SecureRelation& rel1, const SecureRelation& rel2, const StripLayout& layout, size_t i,
+                                   int output_size, SecureRelation& result, int offset) {
+    int cols1 = rel1.columns.size();
+    int cols2 = rel2.columns.size();
+    int tile = std::max(output_size, 1);
+
+    SecureRelation buffer(cols1 + cols2, 0);
+    for (const auto& cell : layout.cells[i]) {
+        const std::pair<int, int>& range1 = layout.strips[0][cell[0]];
+        const std::pair<int, int>& range2 = layout.strips[1][cell[1]];
+        int width2 = range2.second - range2.first + 1;
+        long long pairs = layout.cell_size(cell);
+
+        for (long long begin = 0; begin < pairs; begin += tile) {
+            long long end = std::min(pairs, begin + tile);
+
+            SecureRelation tile_pairs(cols1 + cols2, end - begin);
+            for (long long pair = begin; pair < end; pair++) {
+                int r = range1.first + pair / width2;
+                int s = range2.first + pair % width2;
+                int row = pair - begin;
+                for (int k = 0; k < cols1; k++) {
+                    tile_pairs.columns[k][row] = rel1.columns[k][r];
+                }
+                for (int k = 0; k < cols2; k++) {
+                    tile_pairs.columns[cols1 + k][row] = rel2.columns[k][s];
+                }
+
+                // The offsets are public, so the band test costs one subtraction and two constant comparisons
+                emp::Integer distance = rel2.columns[column_index2][s] - rel1.columns[column_index1][r];
+                emp::Bit in_band = (!PublicCompare::less_than(distance, lower)) & PublicCompare::less_than(distance, upper, true);
+                tile_pairs.flags[row] = bit_to_flag(in_band & flag_bit(rel1.flags[r]) & flag_bit(rel2.flags[s]));
+            }
+
+            buffer.append_and_compact(tile_pairs, output_size);
+        }
+    }
+
+    for (int k = 0; k < cols1 + cols2; k++) {
+        std::move(buffer.columns[k].begin(), buffer.columns[k].end(), result.columns[k].begin() + offset);
+    }
+    std::move(buffer.flags.begin(), buffer.flags.end(), result.flags.begin() + offset);
+}
+
+#endif // BAND_JOIN_OPERATOR_HPP
@@ -0,0 +1,86 @@
+// distinct.hpp
+
+#ifndef DISTINCT_OPERATOR_HPP
+#define DISTINCT_OPERATOR_HPP
+
+#include "core/_op_unary.hpp"
+#include "core/join_key.hpp"
+#include "core/synopsis.hpp"
+#include "util/prefix_scan.hpp"
+#include <vector>
+
+// DISTINCT on a key: of every set of real rows sharing a key, only the first stays real.
+// The input is sorted on the key unless its sortedness says it already is, so equal keys
+// form runs of adjacent rows. A segmented OR over the runs tells whether a real row with
+// the same key comes earlier, and such rows are flagged as dummies. Optionally the result
+// is compacted to the noisy distinct count of a synopsis, keeping the key order.
+// The result has the schema of the input; the other columns come from the first real row of each key.
+class DistinctOperator : public UnaryOperator {
+public:
+    JoinKey key;  // The key, a plain column index or several packed columns
+    bool resize;  // Whether the result is compacted to the synopsis bound
+    Synopsis synopsis;  // Source of the noisy distinct count when resizing
+
+    // Keep all rows, only clearing the flags of duplicates
+    DistinctOperator(const JoinKey& key);
+
+    // Compact the result to the noisy distinct count
+    DistinctOperator(const JoinKey& key, const Synopsis& syn);
+
+protected:
+    SecureRelation operation(const SecureRelation& input) override;
+};
+
+// Definitions
+
+DistinctOperator::DistinctOperator(const JoinKey& key)
+    : key(key), resize(false), synopsis(0) {}
+
+DistinctOperator::DistinctOperator(const JoinKey& key, const Synopsis& syn)
+    : key(key), resize(true), synopsis(syn) {}
+
+SecureRelation DistinctOperator::operation(const SecureRelation& input) {
+    int rows = input.flags.size();
+    SecureRelation output = input;
+    if (rows == 0) {
+        return output;
+    }
+
+    // A composite key is packed into a temporary column, which the sort then orders on
+    bool single_column = key.columns.size() == 1 && key.widths[0] == 32;
+    int key_column = key.columns[0];
+    if (!single_column) {
+        key_column = output.columns.size();
+        output.columns.push_back(key.pack(output));
+    }
+    if (output.sorted_column != key_column) {
+        output.sort_by_column(key_column);
+    }
+
+    // seen[i] = some real row of the run of row i lies at or before i
+    const std::vector<emp::Integer>& keys = output.columns[key_column];
+    std::vector<emp::Bit> heads(rows);
+    heads[0] = Constants::bit(true);
+    for (int i = 1; i < rows; i++) {
+        heads[i] = keys[i] != keys[i - 1];
+    }
+    std::vector<emp::Integer> seen = output.flags;
+    PrefixScan::segmented_scan(seen, heads, PrefixScan::bit_or);
+
+    for (int i = 1; i < rows; i++) {
+        emp::Bit duplicate = (!heads[i]) & flag_bit(seen[i - 1]);
+        output.flags[i] = bit_to_flag(flag_bit(output.flags[i]) & !duplicate);
+    }
+
+    if (!single_column) {
+        output.columns.pop_back();
+        output.sorted_column = -1;
+    }
+
+    if (resize) {
+        output.compact_stable(synopsis.resize_bound(rows));
+    }
+    return output;
+}
+
+#endif // DISTINCT_OPERATOR_HPP
@@ -0,0 +1,57 @@
+// dp_filter.hpp
+
+#ifndef DP_FILTER_OPERATOR_HPP
+#define DP_FILTER_OPERATOR_HPP
+
+#include "core/_op_unary.hpp"
+#include "core/predicate.hpp"
+#include "core/synopsis.hpp"
+#include <algorithm>
+
+// Filter, compaction and DP resize in one pipeline. The input is consumed in tiles:
+// each tile is evaluated and appended to a running buffer that holds the qualifying rows
+// found so far, and the buffer is compacted back to the DP bound whenever it outgrows it.
+// Memory stays at O(bound + tile) and the unfiltered relation is never copied.
+class DPFilterOperator : public UnaryOperator {
+public:
+    Predicate predicate;  // Predicate tree evaluated by the filter
+    Predicate::Compiled compiled;  // Compiled once at construction, evaluated per row
+    Synopsis synopsis;  // Source of the noisy output bound
+
+    DPFilterOperator(const Predicate& pred, const Synopsis& syn);
+
+protected:
+    SecureRelation operation(const SecureRelation& input) override;
+};
+
+// Definitions
+
+DPFilterOperator::DPFilterOperator(const Predicate& pred, const Synopsis& syn)
+    : predicate(pred), compiled(pred.compile()), synopsis(syn) {}
+
+SecureRelation DPFilterOperator::operation(const SecureRelation& input) {
+    int input_size = input.flags.size();
+    int output_size = synopsis.resize_bound(input_size);
+    int tile_size = std::max(output_size, 1);
+
+    SecureRelation buffer(input.columns.size(), 0);
+    for (int begin = 0; begin < input_size; begin += tile_size) {
+        int end = std::min(input_size, begin + tile_size);
+
+        // Evaluate the next tile with its predicate flags; dummy rows stay dummies
+        SecureRelation tile(input.columns.size(), end - begin);
+        for (int i = begin; i < end; i++) {
+            for (size_t col = 0; col < input.columns.size(); col++) {
+                tile.columns[col][i - begin] = input.columns[col][i];
+            }
+            tile.flags[i - begin] = bit_to_flag(compiled(input, i) & flag_bit(input.flags[i]));
+        }
+
+        // Shrink back to the DP bound, keeping the qualifying rows in input order
+        buffer.append_and_compact(tile, output_size);
+    }
+
+    return buffer;
+}
+
+#endif // DP_FILTER_OPERATOR_HPP
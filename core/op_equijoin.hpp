@@ -4,14 +4,15 @@
 #define EQUIJOIN_OPERATOR_HPP
 
 #include "core/_op_binary.hpp"
+#include "core/join_key.hpp"
 #include <vector>
 
 class EquiJoinOperator : public BinaryOperator {
 public:
-    int column_index1;  // The join column index for the first relation
-    int column_index2;  // The join column index for the second relation
+    JoinKey key1;  // The join key of the first relation, a plain column index for single-column keys
+    JoinKey key2;  // The join key of the second relation
 
-    EquiJoinOperator(int col_idx1, int col_idx2);
+    EquiJoinOperator(const JoinKey& key1, const JoinKey& key2);
 
 protected:
     SecureRelation operation(const SecureRelation& rel1, const SecureRelation& rel2) override;
@@ -20,8 +21,10 @@ protected:
 
 // Definitions
 
-EquiJoinOperator::EquiJoinOperator(int col_idx1, int col_idx2) 
-    : column_index1(col_idx1), column_index2(col_idx2) {}
+EquiJoinOperator::EquiJoinOperator(const JoinKey& key1, const JoinKey& key2)
+    : key1(key1), key2(key2) {
+    JoinKey::check_compatible(key1, key2);
+}
 
 SecureRelation EquiJoinOperator::operation(const SecureRelation& rel1, const SecureRelation& rel2) {
     int result_rows = rel1.columns[0].size() * rel2.columns[0].size();
@@ -29,6 +32,10 @@ SecureRelation EquiJoinOperator::operation(const SecureRelation& rel1, const Sec
 
     SecureRelation result(result_cols, result_rows);
 
+    // Packed once per row, so a composite key costs a single equality per pair
+    std::vector<emp::Integer> keys1 = key1.pack(rel1);
+    std::vector<emp::Integer> keys2 = key2.pack(rel2);
+
     for (int i = 0; i < rel1.columns[0].size(); i++) {
         for (int j = 0; j < rel2.columns[0].size(); j++) {
             int result_row_index = i * rel2.columns[0].size() + j;
@@ -44,14 +51,17 @@ SecureRelation EquiJoinOperator::operation(const SecureRelation& rel1, const Sec
             }
 
             // Set the join flag. 1 if the join condition is satisfied, 0 otherwise.
-            emp::Bit join_condition = (rel1.columns[column_index1][i] == rel2.columns[column_index2][j]) 
-                                      & (rel1.flags[i] == emp::Integer(1, 1, ALICE)) 
-                                      & (rel2.flags[j] == emp::Integer(1, 1, ALICE));
+            emp::Bit join_condition = (keys1[i] == keys2[j])
+                                      & flag_bit(rel1.flags[i]) 
+                                      & flag_bit(rel2.flags[j]);
                                       
-            result.flags[result_row_index] = emp::If(join_condition, emp::Integer(1, 1, ALICE), emp::Integer(1, 0, ALICE));
+            result.flags[result_row_index] = bit_to_flag(join_condition);
         }
     }
 
+    // Rows are produced in rel1-major order, so an order of rel1 carries over
+    result.sorted_column = rel1.sorted_column;
+
     return result;
 }
 
@@ -2,55 +2,84 @@
 #define FILTER_OPERATOR_HPP
 
 #include "core/_op_unary.hpp"
+#include "core/predicate.hpp"
 #include <string>
 
+#ifdef MULTI_THREAD
+#include "util/session_pool.hpp"
+#endif
+
 class FilterOperator : public UnaryOperator {
 public:
     int column_index;  // The index of the column on which the filter is applied
     emp::Integer target_value;  // A target value for comparison if it's not a column
     std::vector<emp::Integer> target_column; // A column for comparison, if applicable
     std::string condition;  // One of the conditions: "gt, geq, lt, leq, eq, neq"
-
-    emp::Bit compare(const emp::Integer& a, const emp::Integer& b, const std::string& condition);
+    Predicate predicate;  // Predicate tree evaluated by the filter
+    Predicate::Compiled compiled;  // Compiled once at construction, evaluated per row
 
     // Constructor when target is a single value
     FilterOperator(int col_idx, const emp::Integer& target, const std::string& cnd);
 
+    // Constructor when target is a public constant (uses the reduced constant-comparison circuits)
+    FilterOperator(int col_idx, int64_t target, const std::string& cnd);
+
     // Constructor when target is a column
     FilterOperator(int col_idx, const std::vector<emp::Integer>& target_col, const std::string& cnd);
 
+    // Constructor for an arbitrary predicate tree (AND/OR/NOT, BETWEEN, IN-lists)
+    explicit FilterOperator(const Predicate& pred);
+
     SecureRelation operation(const SecureRelation& input) override;
+
+#ifdef MULTI_THREAD
+    // Parallel mode: rows are split into one chunk per session of the pool
+    SessionPool* pool = nullptr;
+    void set_parallel(SessionPool* session_pool) { pool = session_pool; }
+#endif
+
+private:
+    // Evaluate the predicate on rows [begin, end) of input into the flags of output
+    void evaluate_rows(const SecureRelation& input, SecureRelation& output, int begin, int end);
 };
 
 
 FilterOperator::FilterOperator(int col_idx, const emp::Integer& target, const std::string& cnd) 
-    : column_index(col_idx), target_value(target), condition(cnd) {}
+    : column_index(col_idx), target_value(target), condition(cnd),
+      predicate(Predicate::compare(col_idx, parse_compare_op(cnd), target)), compiled(predicate.compile()) {}
+
+FilterOperator::FilterOperator(int col_idx, int64_t target, const std::string& cnd)
+    : column_index(col_idx), condition(cnd),
+      predicate(Predicate::compare(col_idx, parse_compare_op(cnd), target)), compiled(predicate.compile()) {}
 
 FilterOperator::FilterOperator(int col_idx, const std::vector<emp::Integer>& target_col, const std::string& cnd) 
-    : column_index(col_idx), target_column(target_col), condition(cnd) {}
-
-emp::Bit FilterOperator::compare(const emp::Integer& a, const emp::Integer& b, const std::string& condition) {
-    if (condition == "gt") return a > b;
-    if (condition == "geq") return a >= b;
-    if (condition == "lt") return a < b;
-    if (condition == "leq") return a <= b;
-    if (condition == "eq") return a == b;
-    if (condition == "neq") return a != b;
-    return emp::Bit(false); // Default to false for unsupported conditions
+    : column_index(col_idx), target_column(target_col), condition(cnd),
+      predicate(Predicate::compare_vector(col_idx, parse_compare_op(cnd), target_col)), compiled(predicate.compile()) {}
+
+FilterOperator::FilterOperator(const Predicate& pred)
+    : column_index(-1), predicate(pred), compiled(pred.compile()) {}
+
+void FilterOperator::evaluate_rows(const SecureRelation& input, SecureRelation& output, int begin, int end) {
+    // Rows that are already dummies stay dummies
+    for (int i = begin; i < end; i++) {
+        output.flags[i] = bit_to_flag(compiled(input, i) & flag_bit(input.flags[i]));
+    }
 }
 
 SecureRelation FilterOperator::operation(const SecureRelation& input) {
     SecureRelation output = input; // Make a copy of the input relation
 
-    if (target_column.empty()) { // If the target is a single value
-        for (int i = 0; i < input.columns[0].size(); i++) {
-            output.flags[i] = Integer(1, compare(input.columns[column_index][i], target_value, condition).reveal<bool>(), ALICE);
-        }
-    } else { // If the target is a column
-        for (int i = 0; i < input.columns[0].size(); i++) {
-            output.flags[i] = Integer(1, compare(input.columns[column_index][i], target_column[i], condition).reveal<bool>(), ALICE);
-        }
+#ifdef MULTI_THREAD
+    if (pool != nullptr) {
+        pool->run_chunked(input.flags.size(), [&](int begin, int end) {
+            evaluate_rows(input, output, begin, end);
+        });
+        return output;
     }
+#endif
+
+    // Single pass over the relation
+    evaluate_rows(input, output, 0, input.flags.size());
     return output;
 }
 
@@ -0,0 +1,148 @@
+// group_by.hpp
+
+#ifndef GROUP_BY_OPERATOR_HPP
+#define GROUP_BY_OPERATOR_HPP
+
+#include "core/_op_unary.hpp"
+#include "core/op_aggregate.hpp"
+#include "core/synopsis.hpp"
+#include "util/prefix_scan.hpp"
+#include <vector>
+
+#ifdef MULTI_THREAD
+#include "util/session_pool.hpp"
+#endif
+
+// GROUP BY key with one aggregate per group. The key and the aggregated column are sorted
+// on the key, unless the input already is, so every group is a run of adjacent rows. A segmented scan carries the running
+// aggregate of the current run, restarting wherever the key changes, and the last row of
+// a run holds the aggregate of its group. Only last rows of groups with a real row stay
+// real, and the result is compacted to the noisy group count of the synopsis.
+// Counts are scanned at ceil(log2(rows + 1)) bits and widened to the 32 bits of COUNT once
+// the groups are packed.
+// The result has the columns (key, aggregate), one real row per group in key order.
+class GroupByOperator : public UnaryOperator {
+public:
+    int group_column;  // The grouping key column
+    AggregateOperator aggregate;  // Aggregate computed per group: function, column and SUM width
+    Synopsis synopsis;  // Source of the noisy number of groups
+
+    GroupByOperator(int group_column, const AggregateOperator& aggregate, const Synopsis& syn);
+
+#ifdef MULTI_THREAD
+    // Parallel mode: every level of the segmented scans is split over the sessions of the pool
+    SessionPool* pool = nullptr;
+    void set_parallel(SessionPool* session_pool) { pool = session_pool; }
+#endif
+
+protected:
+    SecureRelation operation(const SecureRelation& input) override;
+};
+
+// Definitions
+
+GroupByOperator::GroupByOperator(int group_column, const AggregateOperator& aggregate, const Synopsis& syn)
+    : group_column(group_column), aggregate(aggregate), synopsis(syn) {}
+
+SecureRelation GroupByOperator::operation(const SecureRelation& input) {
+    int rows = input.flags.size();
+    AggregateOperator::Function function = aggregate.function;
+    if (rows == 0) {
+        return SecureRelation(2, 0);
+    }
+
+    // Only the key and the aggregated column take part in the sort
+    SecureRelation groups(2, rows);
+    groups.columns[0] = input.columns[group_column];
+    groups.columns[1] = input.columns[aggregate.column_index];
+    groups.flags = input.flags;
+    if (input.sorted_column != group_column) {
+        groups.sort_by_column(0);
+    }
+
+    // Condition every row on its flag; COUNT and AVG also count the real rows
+    int value_width = groups.columns[1][0].size();
+    int count_width = AggregateOperator::count_width(rows);
+    int width = function == AggregateOperator::COUNT ? count_width
+              : function == AggregateOperator::MIN || function == AggregateOperator::MAX ? value_width
+              : aggregate.sum_width(rows, value_width);
+    emp::Integer dummy = AggregateOperator::identity(function, width);
+    std::vector<emp::Integer> values(rows), counts;
+    std::vector<emp::Bit> real(rows);
+    for (int i = 0; i < rows; i++) {
+        real[i] = flag_bit(groups.flags[i]);
+        if (function == AggregateOperator::COUNT) {
+            values[i] = Constants::zero(width);
+            values[i][0] = real[i];
+        } else {
+            emp::Integer value = groups.columns[1][i];
+            values[i] = emp::If(real[i], value.resize(width), dummy);
+        }
+    }
+    if (function == AggregateOperator::AVG) {
+        counts.resize(rows);
+        for (int i = 0; i < rows; i++) {
+            counts[i] = Constants::zero(count_width);
+            counts[i][0] = real[i];
+        }
+    }
+
+    // Segmented scans over the runs: a row starts a run iff its key differs from the previous one
+    std::vector<emp::Bit> heads(rows);
+    heads[0] = Constants::bit(true);
+    for (int i = 1; i < rows; i++) {
+        heads[i] = groups.columns[0][i] != groups.columns[0][i - 1];
+    }
+    auto segmented_scan = [&](std::vector<emp::Integer>& column, const PrefixScan::Op& op) {
+#ifdef MULTI_THREAD
+        if (pool != nullptr) {
+            PrefixScan::segmented_scan(column, heads, op, pool);
+            return;
+        }
+#endif
+        PrefixScan::segmented_scan(column, heads, op);
+    };
+    segmented_scan(values, [function](const emp::Integer& a, const emp::Integer& b) {
+        return AggregateOperator::combine(function, a, b);
+    });
+    std::vector<emp::Integer> any_real = groups.flags;
+    segmented_scan(any_real, PrefixScan::bit_or);
+    if (function == AggregateOperator::AVG) {
+        segmented_scan(counts, PrefixScan::add);
+    }
+
+    // The last row of a run with a real row represents its group
+    for (int i = 0; i < rows; i++) {
+        emp::Bit last = i + 1 < rows ? heads[i + 1] : Constants::bit(true);
+        groups.columns[1][i] = values[i];
+        groups.flags[i] = bit_to_flag(last & flag_bit(any_real[i]));
+    }
+
+    if (function == AggregateOperator::AVG) {
+        // Divide after the groups are packed, so only the kept rows pay for a division
+        groups.columns.push_back(counts);
+    }
+
+    groups.compact_stable(synopsis.resize_bound(rows));
+
+    if (function == AggregateOperator::COUNT) {
+        for (auto& count : groups.columns[1]) {
+            count.resize(32, false);
+        }
+    }
+
+    if (function == AggregateOperator::AVG) {
+        emp::Integer one(width, 1, emp::PUBLIC);
+        for (size_t i = 0; i < groups.flags.size(); i++) {
+            // Unsigned count, so it stays a positive divisor of the sum width
+            groups.columns[2][i].resize(width, false);
+            emp::Integer count = emp::If(flag_bit(groups.flags[i]), groups.columns[2][i], one);
+            emp::Integer avg = groups.columns[1][i] / count;
+            groups.columns[1][i] = avg.resize(value_width);
+        }
+        groups.columns.pop_back();
+    }
+    return groups;
+}
+
+#endif // GROUP_BY_OPERATOR_HPP
@@ -5,8 +5,15 @@
 
 #include "core/_op_binary.hpp"
 #include "op_equijoin.hpp"
+#include "op_tiled_equijoin.hpp"
+#include "core/strip_layout.hpp"
 #include <vector>
 #include <utility>
+#include <algorithm>
+
+#ifdef MULTI_THREAD
+#include "util/session_pool.hpp"
+#endif
 
 class IndexEquiJoinOperator : public BinaryOperator {
 public:
@@ -21,124 +28,200 @@ public:
     std::vector<std::pair<int, int>> index1;
     std::vector<std::pair<int, int>> index2;
 
-    int column_index1;
-    int column_index2;
+    JoinKey key1;  // Join key of the first relation, a plain column index for single-column keys
+    JoinKey key2;  // Join key of the second relation
 
     CompactionMode mode;
     int fixed_size;  // Used only when mode is FIXED_SIZE
     int mf1, mf2;
 
-    IndexEquiJoinOperator(const std::vector<std::pair<int, int>>& idx1, const std::vector<std::pair<int, int>>& idx2, int col_idx1, int col_idx2, CompactionMode mode = NONE, int fixed_size = 0, int mf1=1, int mf2=1);
+    // Ranges of the buckets in the last result, filled in by execute
+    std::vector<std::pair<int, int>> output_index;
+
+    IndexEquiJoinOperator(const std::vector<std::pair<int, int>>& idx1, const std::vector<std::pair<int, int>>& idx2, const JoinKey& key1, const JoinKey& key2, CompactionMode mode = NONE, int fixed_size = 0, int mf1=1, int mf2=1);
     
-    // Rebuilding the index
+    // Rebuilding the index: the range of every bucket in the result, known before execution
     std::vector<std::pair<int, int>> rebuild_index();
 
+    // Overlap-aware mode, on by default: noisy ranges of neighbouring buckets overlap, so without
+    // it a pair of rows in the overlap is compared, and a match kept, by every bucket covering both
+    // rows. The rows are cut into disjoint strips at every bucket boundary and each pair of strips
+    // is joined once, by the first bucket covering it; a bucket may end up with an empty range.
+    // Turning it off joins every pair of buckets as a whole, which gives the same rows only when
+    // the indexes of both inputs are disjoint.
+    bool overlap_aware = true;
+    void set_overlap_aware(bool enabled) { overlap_aware = enabled; }
+
+#ifdef MULTI_THREAD
+    // Parallel mode: pairs of buckets are scheduled over the sessions of the pool; a pair
+    // costing more than an even share of a session is split into row ranges of its first bucket
+    SessionPool* pool = nullptr;
+    void set_parallel(SessionPool* session_pool) { pool = session_pool; }
+#endif
+
 protected:
     SecureRelation operation(const SecureRelation& rel1, const SecureRelation& rel2) override;
 
 private:
+    // strips of both inputs and the strip pairs owned by every bucket
+    StripLayout strip_layout();
+
+    // number of rows kept from the strip pairs of one bucket under the compaction mode
+    int cells_size(const StripLayout& layout, size_t i);
+
+    // join the strip pairs of bucket i pair by pair, compacting to output_size while joining;
+    // only rows first_row to last_row of rel1 take part
+    SecureRelation join_cells(const SecureRelation& rel1, const SecureRelation& rel2, const std::vector<emp::Integer>& keys1,
+                              const std::vector<emp::Integer>& keys2, const StripLayout& layout, size_t i, int output_size,
+                              int first_row, int last_row);
+
+    // number of row pairs compared by bucket i for rows first_row to last_row of rel1
+    long long part_cost(const StripLayout& layout, size_t i, int first_row, int last_row);
+
+    // join rows first_row to last_row of rel1 as bucket i would, keeping at most as many rows as bucket i
+    SecureRelation join_part(const SecureRelation& rel1, const SecureRelation& rel2, const std::vector<emp::Integer>& keys1,
+                             const std::vector<emp::Integer>& keys2, const StripLayout& layout, size_t i, int first_row, int last_row);
+
+    // combine the joins of the row ranges of one bucket into the bucket result of output_size rows
+    SecureRelation merge_parts(std::vector<SecureRelation>& parts, int output_size);
+
     // bucketize large join
     std::vector<SecureRelation> bucketize(const SecureRelation& rel, const std::vector<std::pair<int, int>>& index);
    
+    // cut the i-th pair of buckets out of the inputs and join them
+    SecureRelation join_index_pair(const SecureRelation& rel1, const SecureRelation& rel2, size_t i);
+
+    // move a bucket result into its slice of the preallocated result
+    void place_result(SecureRelation&& bucket_result, SecureRelation& result, int offset);
+
+    // join one pair of buckets, compacted according to the mode
+    SecureRelation join_bucket(const SecureRelation& bucket1, const SecureRelation& bucket2);
+
+    // number of rows kept from the join of two buckets of the given sizes under the compaction mode
+    int compact_size(int rows1, int rows2);
+
     // compact bucket join output
     SecureRelation compact_result(SecureRelation& bucket_result, const SecureRelation& rel1, const SecureRelation& rel2);
 };
 
 // Implementations
-IndexEquiJoinOperator::IndexEquiJoinOperator(const std::vector<std::pair<int, int>>& idx1, const std::vector<std::pair<int, int>>& idx2, int col_idx1, int col_idx2, CompactionMode mode, int fixed_size, int mf1, int mf2)
-    : index1(idx1), index2(idx2), column_index1(col_idx1), column_index2(col_idx2), mode(mode), fixed_size(fixed_size), mf1(mf1), mf2(mf2) {}
+IndexEquiJoinOperator::IndexEquiJoinOperator(const std::vector<std::pair<int, int>>& idx1, const std::vector<std::pair<int, int>>& idx2, const JoinKey& key1, const JoinKey& key2, CompactionMode mode, int fixed_size, int mf1, int mf2)
+    : index1(idx1), index2(idx2), key1(key1), key2(key2), mode(mode), fixed_size(fixed_size), mf1(mf1), mf2(mf2) {
+    JoinKey::check_compatible(key1, key2);
+}
 
-#ifndef MULTI_THREAD
 SecureRelation IndexEquiJoinOperator::operation(const SecureRelation& rel1, const SecureRelation& rel2) {
-    EquiJoinOperator join_op(column_index1, column_index2);
-
-    // To hold the final result
-    std::vector<SecureRelation> final_results;
+    // Every bucket size is public, so the result is allocated once and each pair of
+    // buckets moves its rows straight into its own slice
+    output_index = rebuild_index();
+    int total_rows = output_index.empty() ? 0 : output_index.back().second + 1;
+    SecureRelation result(rel1.columns.size() + rel2.columns.size(), total_rows);
 
-    for (size_t i = 0; i < index1.size(); i++) {
-        // Bucketize current pair of indices
-        std::vector<SecureRelation> bucket1 = bucketize(rel1, {index1[i]});
-        std::vector<SecureRelation> bucket2 = bucketize(rel2, {index2[i]});
-        
-        // Perform the equijoin on current pair of buckets
-        SecureRelation join_result = join_op.execute(bucket1[0], bucket2[0]);
-        
-        // Compact the result
-        SecureRelation compacted_result = compact_result(join_result, bucket1[0], bucket2[0]);
-        
-        // Append to the final results
-        final_results.push_back(compacted_result);
+    StripLayout layout;
+    std::vector<emp::Integer> keys1, keys2;
+    if (overlap_aware) {
+        layout = strip_layout();
+        keys1 = key1.pack(rel1);
+        keys2 = key2.pack(rel2);
     }
+    auto join_task = [&](int i) {
+        if (overlap_aware) {
+            int output_size = output_index[i].second - output_index[i].first + 1;
+            place_result(join_cells(rel1, rel2, keys1, keys2, layout, i, output_size, index1[i].first, index1[i].second), result, output_index[i].first);
+        } else {
+            place_result(join_index_pair(rel1, rel2, i), result, output_index[i].first);
+        }
+    };
 
-    // Merge all the results
-    int total_rows = 0;
-    for (const auto& res : final_results) {
-        total_rows += res.columns[0].size();
-    }
+#ifdef MULTI_THREAD
+    if (pool != nullptr) {
+        // Bucket sizes are skewed, so pairs are scheduled by their join cost |b1| * |b2|
+        // with work stealing; the pool keeps the pair-to-channel mapping identical for both parties.
+        // The slices are disjoint, so the workers write to the result without locking.
+        std::vector<long long> costs(index1.size());
+        long long total_cost = 0;
+        for (size_t i = 0; i < index1.size(); i++) {
+            costs[i] = part_cost(layout, i, index1[i].first, index1[i].second);
+            total_cost += costs[i];
+        }
 
-    SecureRelation result(rel1.columns.size() + rel2.columns.size(), total_rows);
-    int offset = 0;
-    for (const auto& res : final_results) {
-        for (size_t j = 0; j < res.columns[0].size(); j++) {
-            for (size_t k = 0; k < result.columns.size(); k++) {
-                result.columns[k][offset + j] = res.columns[k][j];
+        // A pair above an even share would alone set the makespan, so it is cut into row ranges
+        // of its first bucket, joined as separate tasks and merged into its slice afterwards
+        long long share = std::max(1LL, (total_cost + pool->size() - 1) / pool->size());
+        std::vector<std::vector<std::pair<int, int>>> parts(index1.size());
+        std::vector<std::pair<int, int>> tasks;  // (bucket, part)
+        std::vector<long long> task_costs;
+        for (size_t i = 0; i < index1.size(); i++) {
+            int rows1 = index1[i].second - index1[i].first + 1;
+            int count = static_cast<int>(std::min<long long>(rows1, (costs[i] + share - 1) / share));
+            if (count <= 1) {
+                parts[i].push_back(index1[i]);
+                tasks.push_back({static_cast<int>(i), 0});
+                task_costs.push_back(costs[i]);
+                continue;
+            }
+            for (int p = 0; p < count; p++) {
+                int first_row = index1[i].first + static_cast<long long>(rows1) * p / count;
+                int last_row = index1[i].first + static_cast<long long>(rows1) * (p + 1) / count - 1;
+                parts[i].push_back({first_row, last_row});
+                tasks.push_back({static_cast<int>(i), p});
+                task_costs.push_back(part_cost(layout, i, first_row, last_row));
             }
-            result.flags[offset + j] = res.flags[j];
         }
-        offset += res.columns[0].size();
-    }
 
-    return result;
-}
-#else
-SecureRelation IndexEquiJoinOperator::operation(const SecureRelation& rel1, const SecureRelation& rel2) {
-    EquiJoinOperator join_op(column_index1, column_index2);
-
-    // Preallocate space for the final results
-    std::vector<SecureRelation> final_results(index1.size());
-    std::vector<std::thread> threads;
-
-    for (size_t i = 0; i < index1.size(); i++) {
-        threads.emplace_back([&, i] {
-            // Bucketize current pair of indices
-            std::vector<SecureRelation> bucket1 = bucketize(rel1, {index1[i]});
-            std::vector<SecureRelation> bucket2 = bucketize(rel2, {index2[i]});
-
-            // Perform the equijoin on current pair of buckets
-            SecureRelation join_result = join_op.execute(bucket1[0], bucket2[0]);
+        std::vector<std::vector<SecureRelation>> part_results(index1.size());
+        std::vector<int> split_buckets;
+        std::vector<long long> merge_costs;
+        for (size_t i = 0; i < index1.size(); i++) {
+            if (parts[i].size() > 1) {
+                part_results[i].resize(parts[i].size());
+                split_buckets.push_back(i);
+                merge_costs.push_back(static_cast<long long>(parts[i].size()) * (output_index[i].second - output_index[i].first + 1));
+            }
+        }
 
-            // Compact the result
-            final_results[i] = compact_result(join_result, bucket1[0], bucket2[0]);
+        pool->run_scheduled(task_costs, [&](int t) {
+            int i = tasks[t].first;
+            if (parts[i].size() == 1) {
+                join_task(i);
+            } else {
+                const std::pair<int, int>& rows = parts[i][tasks[t].second];
+                part_results[i][tasks[t].second] = join_part(rel1, rel2, keys1, keys2, layout, i, rows.first, rows.second);
+            }
         });
+        if (!split_buckets.empty()) {
+            pool->run_scheduled(merge_costs, [&](int t) {
+                int i = split_buckets[t];
+                int output_size = output_index[i].second - output_index[i].first + 1;
+                place_result(merge_parts(part_results[i], output_size), result, output_index[i].first);
+            });
+        }
+        return result;
     }
+#endif
 
-    // Wait for all threads to finish
-    for (auto& thread : threads) {
-        thread.join();
+    for (size_t i = 0; i < index1.size(); i++) {
+        join_task(i);
     }
 
-    // Merge all the results
-    int total_rows = 0;
-    for (const auto& res : final_results) {
-        total_rows += res.columns[0].size();
-    }
+    return result;
+}
 
-    SecureRelation result(rel1.columns.size() + rel2.columns.size(), total_rows);
-    int offset = 0;
-    for (const auto& res : final_results) {
-        for (size_t j = 0; j < res.columns[0].size(); j++) {
-            for (size_t k = 0; k < result.columns.size(); k++) {
-                result.columns[k][offset + j] = res.columns[k][j];
-            }
-            result.flags[offset + j] = res.flags[j];
-        }
-        offset += res.columns[0].size();
-    }
+SecureRelation IndexEquiJoinOperator::join_index_pair(const SecureRelation& rel1, const SecureRelation& rel2, size_t i) {
+    // Bucketize current pair of indices
+    std::vector<SecureRelation> bucket1 = bucketize(rel1, {index1[i]});
+    std::vector<SecureRelation> bucket2 = bucketize(rel2, {index2[i]});
 
-    return result;
+    // Perform the equijoin on current pair of buckets and compact the result
+    return join_bucket(bucket1[0], bucket2[0]);
 }
 
-#endif
+void IndexEquiJoinOperator::place_result(SecureRelation&& bucket_result, SecureRelation& result, int offset) {
+    for (size_t k = 0; k < result.columns.size(); k++) {
+        std::move(bucket_result.columns[k].begin(), bucket_result.columns[k].end(), result.columns[k].begin() + offset);
+    }
+    std::move(bucket_result.flags.begin(), bucket_result.flags.end(), result.flags.begin() + offset);
+}
 
 std::vector<SecureRelation> IndexEquiJoinOperator::bucketize(const SecureRelation& rel, const std::vector<std::pair<int, int>>& index) {
     std::vector<SecureRelation> buckets;
@@ -163,26 +246,41 @@ std::vector<SecureRelation> IndexEquiJoinOperator::bucketize(const SecureRelatio
     return buckets;
 }
 
-SecureRelation IndexEquiJoinOperator::compact_result(SecureRelation& bucket_result, const SecureRelation& rel1, const SecureRelation& rel2) {
-    int compact_size = bucket_result.columns[0].size(); 
+SecureRelation IndexEquiJoinOperator::join_bucket(const SecureRelation& bucket1, const SecureRelation& bucket2) {
+    if (mode == NONE) {
+        EquiJoinOperator join_op(key1, key2);
+        SecureRelation join_result = join_op.execute(bucket1, bucket2);
+        return compact_result(join_result, bucket1, bucket2);
+    }
+
+    // The output is bounded, so compact while joining instead of materializing the cross product
+    TiledEquiJoinOperator join_op(key1, key2, compact_size(bucket1.flags.size(), bucket2.flags.size()));
+    return join_op.execute(bucket1, bucket2);
+}
+
+int IndexEquiJoinOperator::compact_size(int rows1, int rows2) {
+    int compact_size = rows1 * rows2;
     switch (mode) {
         case SMALLER_REL:
-            compact_size = std::min(rel1.columns[0].size(), rel2.columns[0].size());
+            compact_size = std::min(rows1, rows2);
             break;
         case LARGER_REL:
-            compact_size = std::max(rel1.columns[0].size(), rel2.columns[0].size());
+            compact_size = std::max(rows1, rows2);
             break;
         case FIXED_SIZE:
             compact_size = fixed_size;
             break;
         case MF:
-            compact_size = std::min({static_cast<int>(rel1.columns[0].size() * mf2),
-                                     static_cast<int>(rel2.columns[0].size() * mf1),
-                                     static_cast<int>(rel1.columns[0].size() * rel2.columns[0].size())});
+            compact_size = std::min({rows1 * mf2, rows2 * mf1, rows1 * rows2});
             break;
         default:
             break;
     }
+    return compact_size;
+}
+
+SecureRelation IndexEquiJoinOperator::compact_result(SecureRelation& bucket_result, const SecureRelation& rel1, const SecureRelation& rel2) {
+    int compact_size = this->compact_size(rel1.flags.size(), rel2.flags.size());
 
     // Sort the bucket result by flag
     bucket_result.sort_by_flag();
@@ -207,29 +305,15 @@ std::vector<std::pair<int, int>> IndexEquiJoinOperator::rebuild_index() {
     std::vector<std::pair<int, int>> new_index;
     int start_idx = 0;
 
+    StripLayout layout;
+    if (overlap_aware) {
+        layout = strip_layout();
+    }
+
     for (size_t i = 0; i < index1.size(); i++) {
-        int original_size = index1[i].second - index1[i].first + 1;
-        int compacted_size = 0;
-
-        // Determine compacted size based on compaction mode
-        switch (mode) {
-            case SMALLER_REL:
-                compacted_size = std::min(index1[i].second - index1[i].first + 1, index2[i].second - index2[i].first + 1);
-                break;
-            case LARGER_REL:
-                compacted_size = std::max(index1[i].second - index1[i].first + 1, index2[i].second - index2[i].first + 1);
-                break;
-            case FIXED_SIZE:
-                compacted_size = fixed_size;
-                break;
-            case MF:
-                compacted_size = std::min(static_cast<int>(original_size * mf2),
-                                          static_cast<int>(original_size * mf1));
-                break;
-            default:
-                compacted_size = original_size; // For NONE mode or any other unspecified mode
-                break;
-        }
+        // Same rule as the compaction of the bucket itself
+        int compacted_size = overlap_aware ? cells_size(layout, i)
+                           : compact_size(index1[i].second - index1[i].first + 1, index2[i].second - index2[i].first + 1);
 
         int end_idx = start_idx + compacted_size - 1;
         new_index.push_back({start_idx, end_idx});
@@ -239,4 +323,114 @@ std::vector<std::pair<int, int>> IndexEquiJoinOperator::rebuild_index() {
     return new_index;
 }
 
+StripLayout IndexEquiJoinOperator::strip_layout() {
+    return StripLayout({index1, index2});
+}
+
+// A row pair belongs to exactly one strip pair, so the rows of a bucket are the distinct strips
+// of its cells and the usual bounds apply to them, capped by the number of pairs compared
+int IndexEquiJoinOperator::cells_size(const StripLayout& layout, size_t i) {
+    long long pairs = 0;
+    for (const auto& cell : layout.cells[i]) {
+        pairs += layout.cell_size(cell);
+    }
+    std::vector<int> rows = layout.covered_rows(i);
+    return static_cast<int>(std::min<long long>(compact_size(rows[0], rows[1]), pairs));
+}
+
+SecureRelation IndexEquiJoinOperator::join_cells(const SecureRelation& rel1, const SecureRelation& rel2, const std::vector<emp::Integer>& keys1,
+                                                 const std::vector<emp::Integer>& keys2, const StripLayout& layout, size_t i, int output_size,
+                                                 int first_row, int last_row) {
+    int cols1 = rel1.columns.size();
+    int cols2 = rel2.columns.size();
+    int tile = std::max(output_size, 1);
+
+    // Same scheme as TiledEquiJoinOperator over the row pairs of all cells of the bucket
+    SecureRelation buffer(cols1 + cols2, 0);
+    SecureRelation pairs(cols1 + cols2, 0);
+    auto flush = [&]() {
+        buffer.append_and_compact(pairs, output_size);
+        pairs = SecureRelation(cols1 + cols2, 0);
+    };
+    for (const auto& cell : layout.cells[i]) {
+        const auto& strip1 = layout.strips[0][cell[0]];
+        const auto& strip2 = layout.strips[1][cell[1]];
+        for (int r = std::max(strip1.first, first_row); r <= std::min(strip1.second, last_row); r++) {
+            for (int s = strip2.first; s <= strip2.second; s++) {
+                for (int k = 0; k < cols1; k++) {
+                    pairs.columns[k].push_back(rel1.columns[k][r]);
+                }
+                for (int k = 0; k < cols2; k++) {
+                    pairs.columns[cols1 + k].push_back(rel2.columns[k][s]);
+                }
+                emp::Bit join_condition = (keys1[r] == keys2[s]) & flag_bit(rel1.flags[r]) & flag_bit(rel2.flags[s]);
+                pairs.flags.push_back(bit_to_flag(join_condition));
+
+                if (static_cast<int>(pairs.flags.size()) == tile) {
+                    flush();
+                }
+            }
+        }
+    }
+    flush();
+    return buffer;
+}
+
+long long IndexEquiJoinOperator::part_cost(const StripLayout& layout, size_t i, int first_row, int last_row) {
+    if (!overlap_aware) {
+        return static_cast<long long>(last_row - first_row + 1) * (index2[i].second - index2[i].first + 1);
+    }
+    long long cost = 0;
+    for (const auto& cell : layout.cells[i]) {
+        const auto& strip1 = layout.strips[0][cell[0]];
+        const auto& strip2 = layout.strips[1][cell[1]];
+        int rows = std::min(strip1.second, last_row) - std::max(strip1.first, first_row) + 1;
+        if (rows > 0) {
+            cost += static_cast<long long>(rows) * (strip2.second - strip2.first + 1);
+        }
+    }
+    return cost;
+}
+
+SecureRelation IndexEquiJoinOperator::join_part(const SecureRelation& rel1, const SecureRelation& rel2, const std::vector<emp::Integer>& keys1,
+                                                const std::vector<emp::Integer>& keys2, const StripLayout& layout, size_t i, int first_row, int last_row) {
+    // A part never has more matches than its bucket, nor more than the pairs it compares
+    int bucket_size = output_index[i].second - output_index[i].first + 1;
+    int output_size = static_cast<int>(std::min<long long>(bucket_size, part_cost(layout, i, first_row, last_row)));
+    if (overlap_aware) {
+        return join_cells(rel1, rel2, keys1, keys2, layout, i, output_size, first_row, last_row);
+    }
+
+    std::vector<SecureRelation> part1 = bucketize(rel1, {{first_row, last_row}});
+    std::vector<SecureRelation> bucket2 = bucketize(rel2, {index2[i]});
+    if (mode == NONE) {
+        EquiJoinOperator join_op(key1, key2);
+        return join_op.execute(part1[0], bucket2[0]);
+    }
+    TiledEquiJoinOperator join_op(key1, key2, output_size);
+    return join_op.execute(part1[0], bucket2[0]);
+}
+
+SecureRelation IndexEquiJoinOperator::merge_parts(std::vector<SecureRelation>& parts, int output_size) {
+    SecureRelation merged = std::move(parts[0]);
+    for (size_t p = 1; p < parts.size(); p++) {
+        for (size_t k = 0; k < merged.columns.size(); k++) {
+            merged.columns[k].insert(merged.columns[k].end(), parts[p].columns[k].begin(), parts[p].columns[k].end());
+        }
+        merged.flags.insert(merged.flags.end(), parts[p].flags.begin(), parts[p].flags.end());
+    }
+
+    // Same layout as the unsplit bucket: NONE sorts by flag, the other modes compact; exactly output_size rows
+    if (!overlap_aware && mode == NONE) {
+        merged.sort_by_flag();
+    } else if (static_cast<int>(merged.flags.size()) > output_size) {
+        merged.compact_stable(output_size);
+    }
+    for (auto& column : merged.columns) {
+        column.resize(output_size, Constants::zero());
+    }
+    merged.flags.resize(output_size, Constants::flag(false));
+    return merged;
+}
+
 #endif // INDEX_EQUIJOIN_OPERATOR_HPP
@@ -0,0 +1,61 @@
+// index_filter.hpp
+
+#ifndef INDEX_FILTER_OPERATOR_HPP
+#define INDEX_FILTER_OPERATOR_HPP
+
+#include "core/_op_unary.hpp"
+#include "core/predicate.hpp"
+#include "core/synopsis.hpp"
+#include <algorithm>
+
+// Range selection over a relation sorted on column_index. The noisy CDF index of the
+// synopsis tells which rows can hold values in [lower, upper]; only those rows are
+// scanned and returned, so the cost follows the noisy output size instead of |input|.
+class IndexFilterOperator : public UnaryOperator {
+public:
+    int column_index;  // Column the relation is sorted on
+    int64_t lower;  // Inclusive public bounds of the range predicate
+    int64_t upper;
+    Synopsis synopsis;  // Noisy CDF index and bin layout of column_index
+    Predicate predicate;  // Range predicate, plus any residual conjuncts
+    Predicate::Compiled compiled;
+
+    IndexFilterOperator(int col_idx, int64_t lower, int64_t upper, const Synopsis& syn);
+
+    // Range predicate AND a residual predicate evaluated on the scanned rows only
+    IndexFilterOperator(int col_idx, int64_t lower, int64_t upper, const Synopsis& syn, const Predicate& residual);
+
+protected:
+    SecureRelation operation(const SecureRelation& input) override;
+};
+
+// Definitions
+
+IndexFilterOperator::IndexFilterOperator(int col_idx, int64_t lower, int64_t upper, const Synopsis& syn)
+    : column_index(col_idx), lower(lower), upper(upper), synopsis(syn),
+      predicate(Predicate::between(col_idx, lower, upper)), compiled(predicate.compile()) {}
+
+IndexFilterOperator::IndexFilterOperator(int col_idx, int64_t lower, int64_t upper, const Synopsis& syn, const Predicate& residual)
+    : column_index(col_idx), lower(lower), upper(upper), synopsis(syn),
+      predicate(Predicate::between(col_idx, lower, upper) && residual), compiled(predicate.compile()) {}
+
+SecureRelation IndexFilterOperator::operation(const SecureRelation& input) {
+    std::pair<int, int> range = synopsis.covering_range(lower, upper);
+    int first = std::max(range.first, 0);
+    int last = std::min(range.second, static_cast<int>(input.flags.size()) - 1);
+    int output_size = std::max(0, last - first + 1);
+
+    SecureRelation output(input.columns.size(), output_size);
+    for (size_t col = 0; col < input.columns.size(); col++) {
+        for (int row = first; row <= last; row++) {
+            output.columns[col][row - first] = input.columns[col][row];
+        }
+    }
+    for (int row = first; row <= last; row++) {
+        output.flags[row - first] = bit_to_flag(compiled(input, row) & flag_bit(input.flags[row]));
+    }
+
+    return output;
+}
+
+#endif // INDEX_FILTER_OPERATOR_HPP
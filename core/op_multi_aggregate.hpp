@@ -0,0 +1,47 @@
+// multi_aggregate.hpp
+
+#ifndef MULTI_AGGREGATE_OPERATOR_HPP
+#define MULTI_AGGREGATE_OPERATOR_HPP
+
+#include "core/_op_unary.hpp"
+#include "core/op_aggregate.hpp"
+#include <vector>
+#include <stdexcept>
+
+// Several scalar aggregates over the same relation in one pass, e.g. COUNT, SUM and MAX for
+// a dashboard. The flags are conditioned into each column once and shared, and SUM and AVG
+// of one column share their sum tree, COUNT and AVG their count of real rows.
+// The result is a one-row relation with one column per aggregate, in list order. The row
+// is real unless some aggregate other than COUNT ran over no real rows, like SQL's NULL.
+class MultiAggregateOperator : public UnaryOperator {
+public:
+    std::vector<AggregateOperator> aggregates;  // Function, column and SUM width of every aggregate
+
+    MultiAggregateOperator(const std::vector<AggregateOperator>& aggregates);
+
+protected:
+    SecureRelation operation(const SecureRelation& relation) override;
+};
+
+// Definitions
+
+MultiAggregateOperator::MultiAggregateOperator(const std::vector<AggregateOperator>& aggregates)
+    : aggregates(aggregates) {
+    if (aggregates.empty()) {
+        throw std::invalid_argument("Multi-aggregate needs at least one aggregate");
+    }
+}
+
+SecureRelation MultiAggregateOperator::operation(const SecureRelation& relation) {
+    emp::Bit real_result;
+    std::vector<emp::Integer> values = AggregateOperator::evaluate(aggregates, relation, real_result);
+
+    SecureRelation result(aggregates.size(), 1);
+    for (size_t k = 0; k < values.size(); k++) {
+        result.columns[k][0] = values[k];
+    }
+    result.flags[0] = bit_to_flag(real_result);
+    return result;
+}
+
+#endif // MULTI_AGGREGATE_OPERATOR_HPP
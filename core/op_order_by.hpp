@@ -0,0 +1,123 @@
+// order_by.hpp
+
+#ifndef ORDER_BY_OPERATOR_HPP
+#define ORDER_BY_OPERATOR_HPP
+
+#include "core/_op_unary.hpp"
+#include <vector>
+#include <stdexcept>
+#include <string>
+#include <cstdint>
+#include <algorithm>
+
+// ORDER BY column LIMIT k through a top-k selection network instead of a full sort. The
+// input is consumed in blocks of K rows, K the power of two at or above k. The best K rows
+// so far are kept sorted; every block is sorted the other way round, so both together form
+// a bitonic sequence, and one layer of compare-exchanges between them moves the best K of
+// the 2K rows into the kept half, which a bitonic merge sorts again. That is O(n log^2 k)
+// comparisons instead of the O(n log^2 n) of sorting the whole relation.
+// Dummy rows order after every real row. The result has the schema of the input and
+// exactly k rows in the requested order, padded with dummy rows when there are fewer real rows.
+// The sort key is two bits wider than the ordering column, so columns wider than 62 bits are rejected.
+class OrderByLimitOperator : public UnaryOperator {
+public:
+    int column_index;  // The ordering column
+    int limit;         // Number of rows kept, k
+    bool ascending;    // ORDER BY ... ASC or DESC
+
+    OrderByLimitOperator(int column_index, int limit, bool ascending = true);
+
+protected:
+    SecureRelation operation(const SecureRelation& input) override;
+
+private:
+    // Rows [begin, begin + count) of input with the ordering key appended, padded with dummies
+    SecureRelation block(const SecureRelation& input, int begin, int count, int padded_count);
+};
+
+// Definitions
+
+OrderByLimitOperator::OrderByLimitOperator(int column_index, int limit, bool ascending)
+    : column_index(column_index), limit(limit), ascending(ascending) {
+    if (limit < 0) {
+        throw std::invalid_argument("ORDER BY limit must not be negative");
+    }
+}
+
+SecureRelation OrderByLimitOperator::operation(const SecureRelation& input) {
+    int rows = input.flags.size();
+    int cols = input.columns.size();
+    if (rows > 0 && input.columns[column_index][0].size() > Constants::MAX_WIDTH - 2) {
+        throw std::invalid_argument("ORDER BY column is " + std::to_string(input.columns[column_index][0].size()) +
+                                    " bits wide, at most " + std::to_string(Constants::MAX_WIDTH - 2) + " are supported");
+    }
+    int block_size = 1;
+    while (block_size < limit) block_size <<= 1;
+
+    SecureRelation best;
+    if (rows <= block_size) {
+        // The whole input fits one block: a plain sort
+        best = block(input, 0, rows, rows);
+        best.bitonic_sort(0, rows, ascending, best.columns[cols]);
+    } else {
+        best = block(input, 0, block_size, block_size);
+        best.bitonic_sort(0, block_size, ascending, best.columns[cols]);
+
+        for (int begin = block_size; begin < rows; begin += block_size) {
+            SecureRelation next = block(input, begin, std::min(block_size, rows - begin), block_size);
+            next.bitonic_sort(0, block_size, !ascending, next.columns[cols]);
+
+            // best followed by next is bitonic; the half-cleaner leaves the better row of each pair in best
+            for (int k = 0; k <= cols; k++) {
+                best.columns[k].insert(best.columns[k].end(), next.columns[k].begin(), next.columns[k].end());
+            }
+            best.flags.insert(best.flags.end(), next.flags.begin(), next.flags.end());
+            for (int i = 0; i < block_size; i++) {
+                emp::Bit swap = (best.columns[cols][i] > best.columns[cols][i + block_size]) == ascending;
+                best.swap_rows(i, i + block_size, swap);
+            }
+            for (auto& column : best.columns) {
+                column.resize(block_size);
+            }
+            best.flags.resize(block_size);
+            best.bitonic_merge(0, block_size, ascending, best.columns[cols]);
+        }
+    }
+
+    // Drop the key and keep exactly limit rows
+    best.columns.pop_back();
+    for (auto& column : best.columns) {
+        column.resize(limit, Constants::zero());
+    }
+    best.flags.resize(limit, Constants::flag(false));
+    best.sorted_column = ascending ? column_index : -1;
+    return best;
+}
+
+SecureRelation OrderByLimitOperator::block(const SecureRelation& input, int begin, int count, int padded_count) {
+    int cols = input.columns.size();
+    SecureRelation result(cols + 1, padded_count);
+    for (int k = 0; k < cols; k++) {
+        std::copy(input.columns[k].begin() + begin, input.columns[k].begin() + begin + count, result.columns[k].begin());
+    }
+    std::copy(input.flags.begin() + begin, input.flags.begin() + begin + count, result.flags.begin());
+
+    // Key two bits wider than the column, so dummies can take a value beyond every real one:
+    // the largest key when ascending, the smallest when descending
+    int width = count > 0 ? input.columns[column_index][begin].size() + 2 : 34;
+    int64_t bound = int64_t(1) << (width - 2);
+    emp::Integer dummy_key(width, ascending ? bound : -bound - 1, emp::PUBLIC);
+    for (int i = 0; i < padded_count; i++) {
+        if (i < count) {
+            emp::Integer key = input.columns[column_index][begin + i];
+            key.resize(width);
+            result.columns[cols][i] = emp::If(flag_bit(result.flags[i]), key, dummy_key);
+        } else {
+            result.columns[cols][i] = dummy_key;
+            result.flags[i] = Constants::flag(false);
+        }
+    }
+    return result;
+}
+
+#endif // ORDER_BY_OPERATOR_HPP
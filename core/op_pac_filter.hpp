@@ -2,9 +2,14 @@
 #define PACFILTER_OPERATOR_HPP
 
 #include "core/_op_unary.hpp"
+#include "core/predicate.hpp"
 #include <string>
 #include <vector>
 
+#ifdef MULTI_THREAD
+#include "util/session_pool.hpp"
+#endif
+
 class PACFilterOperator : public UnaryOperator {
 public:
     int column_index; // The index of the column on which the filter is applied
@@ -12,69 +17,89 @@ public:
     std::vector<emp::Integer> target_column; // Column for comparison, if applicable
     std::string condition; // Condition: "gt", "geq", "lt", "leq", "eq", "neq"
     int truncation_size; // Desired size of the output relation after filtering
+    Predicate predicate; // Predicate tree evaluated by the filter
+    Predicate::Compiled compiled; // Compiled once at construction, evaluated per row
 
-    emp::Bit compare(const emp::Integer& a, const emp::Integer& b, const std::string& condition);
     SecureRelation operation(const SecureRelation& input) override;
 
     // Constructor when target is a single value
     PACFilterOperator(int col_idx, const emp::Integer& target, const std::string& cnd, int trunc_size);
 
+    // Constructor when target is a public constant (uses the reduced constant-comparison circuits)
+    PACFilterOperator(int col_idx, int64_t target, const std::string& cnd, int trunc_size);
+
     // Constructor when target is a column
     PACFilterOperator(int col_idx, const std::vector<emp::Integer>& target_col, const std::string& cnd, int trunc_size);
+
+    // Constructor for an arbitrary predicate tree (AND/OR/NOT, BETWEEN, IN-lists)
+    PACFilterOperator(const Predicate& pred, int trunc_size);
+
+#ifdef MULTI_THREAD
+    // Parallel mode: predicate evaluation is split into one chunk per session of the pool
+    SessionPool* pool = nullptr;
+    void set_parallel(SessionPool* session_pool) { pool = session_pool; }
+#endif
+
+private:
+    // Evaluate the predicate on rows [begin, end) of input into the flags of output
+    void evaluate_rows(const SecureRelation& input, SecureRelation& output, int begin, int end);
 };
 
 // Definitions
 
 PACFilterOperator::PACFilterOperator(int col_idx, const emp::Integer& target, const std::string& cnd, int trunc_size) 
-    : column_index(col_idx), target_value(target), condition(cnd), truncation_size(trunc_size) {}
+    : column_index(col_idx), target_value(target), condition(cnd), truncation_size(trunc_size),
+      predicate(Predicate::compare(col_idx, parse_compare_op(cnd), target)), compiled(predicate.compile()) {}
 
-PACFilterOperator::PACFilterOperator(int col_idx, const std::vector<emp::Integer>& target_col, const std::string& cnd, int trunc_size) 
-    : column_index(col_idx), target_column(target_col), condition(cnd), truncation_size(trunc_size) {}
-
-emp::Bit PACFilterOperator::compare(const emp::Integer& a, const emp::Integer& b, const std::string& condition) {
-    if (condition == "gt") return a > b;
-    if (condition == "geq") return a >= b;
-    if (condition == "lt") return a < b;
-    if (condition == "leq") return a <= b;
-    if (condition == "eq") return a == b;
-    if (condition == "neq") return a != b;
-    return emp::Bit(false); // Default to false for unsupported conditions
-}
+PACFilterOperator::PACFilterOperator(int col_idx, int64_t target, const std::string& cnd, int trunc_size)
+    : column_index(col_idx), condition(cnd), truncation_size(trunc_size),
+      predicate(Predicate::compare(col_idx, parse_compare_op(cnd), target)), compiled(predicate.compile()) {}
 
-SecureRelation PACFilterOperator::operation(const SecureRelation& input) {
-    SecureRelation output(input.columns.size(), truncation_size); // Initialize output relation with truncation size
+PACFilterOperator::PACFilterOperator(int col_idx, const std::vector<emp::Integer>& target_col, const std::string& cnd, int trunc_size) 
+    : column_index(col_idx), target_column(target_col), condition(cnd), truncation_size(trunc_size),
+      predicate(Predicate::compare_vector(col_idx, parse_compare_op(cnd), target_col)), compiled(predicate.compile()) {}
 
-    emp::Integer last_written_index(32, -1, ALICE);  // -1 indicates that no actual write has been done yet
-    emp::Integer actual_writes_counter(32, 0, ALICE); // Counts the actual writes made
+PACFilterOperator::PACFilterOperator(const Predicate& pred, int trunc_size)
+    : column_index(-1), truncation_size(trunc_size), predicate(pred), compiled(pred.compile()) {}
 
-    // Initialize output's flags to all zeros
-    for (int j = 0; j < truncation_size; j++) {
-        output.flags[j] = Integer(1, 0, ALICE);
+void PACFilterOperator::evaluate_rows(const SecureRelation& input, SecureRelation& output, int begin, int end) {
+    // Dummy rows in the input stay dummies
+    for (int i = begin; i < end; i++) {
+        output.flags[i] = bit_to_flag(compiled(input, i) & flag_bit(input.flags[i]));
     }
+}
 
-    for (int i = 0; i < input.columns[0].size(); i++) {
-        emp::Bit satisfies_condition;
-        if (target_column.empty()) { // If the target is a single value
-            satisfies_condition = compare(input.columns[column_index][i], target_value, condition) & (input.flags[i] == Integer(1, 1, ALICE));
-        } else { // If the target is a column
-            satisfies_condition = compare(input.columns[column_index][i], target_column[i], condition) & (input.flags[i] == Integer(1, 1, ALICE));
-        }
+SecureRelation PACFilterOperator::operation(const SecureRelation& input) {
+    SecureRelation output = input;
+
+    // Evaluate the predicate over every row
+#ifdef MULTI_THREAD
+    if (pool != nullptr) {
+        pool->run_chunked(input.flags.size(), [&](int begin, int end) {
+            evaluate_rows(input, output, begin, end);
+        });
+    } else {
+        evaluate_rows(input, output, 0, input.flags.size());
+    }
+#else
+    evaluate_rows(input, output, 0, input.flags.size());
+#endif
 
-        emp::Bit is_write_position = (last_written_index + Integer(32, 1, ALICE) < Integer(32, truncation_size, ALICE)) & satisfies_condition;
+    // Keep the first truncation_size qualifying rows, in input order
+    output.compact_stable(truncation_size);
 
-        for (int j = 0; j < truncation_size; j++) {
-            emp::Bit is_current_position = (Integer(32, j, ALICE) == (last_written_index + Integer(32, 1, ALICE))) & is_write_position;
+    // Pad short inputs up to the truncation size
+    for (auto& column : output.columns) {
+        column.resize(truncation_size, Constants::zero());
+    }
+    output.flags.resize(truncation_size, Constants::flag(false));
 
-            for (int col = 0; col < input.columns.size(); col++) {
-                output.columns[col][j] = If(is_current_position, input.columns[col][i], output.columns[col][j]);
-            }
-            output.flags[j] = If(is_current_position, Integer(1, 1, ALICE), output.flags[j]);
+    // Slots without a qualifying row carry no data
+    for (int j = 0; j < truncation_size; j++) {
+        emp::Bit occupied = flag_bit(output.flags[j]);
+        for (auto& column : output.columns) {
+            column[j] = emp::If(occupied, column[j], Constants::zero(column[j].size()));
         }
-        // Update last_written_index if an actual write happened
-        last_written_index = If(is_write_position, last_written_index + Integer(32, 1, ALICE), last_written_index);
-
-        // Increment the actual writes counter if an actual write happened
-        actual_writes_counter = If(is_write_position, actual_writes_counter + Integer(32, 1, ALICE), actual_writes_counter);
     }
 
     return output;
@@ -28,6 +28,9 @@ protected:
                 throw std::invalid_argument("Invalid column index " + std::to_string(column_indexes[i]));
             }
             output.columns[i] = input.columns[column_indexes[i]];
+            if (column_indexes[i] == input.sorted_column) {
+                output.sorted_column = i;
+            }
         }
 
         // Copy the flag column to the output
@@ -0,0 +1,71 @@
+// semijoin.hpp
+
+#ifndef SEMIJOIN_OPERATOR_HPP
+#define SEMIJOIN_OPERATOR_HPP
+
+#include "core/_op_binary.hpp"
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+// Left semi-join: the result is rel1 itself, with a row flagged real iff it was real and
+// its key matches some real row of rel2. The output has |rel1| rows instead of a padded
+// cross product, which is all EXISTS and COUNT(DISTINCT key) plans need. With DP indexes
+// only the rows of corresponding buckets are compared; the match bits are accumulated in
+// the rows' own positions, so a row covered by several overlapping buckets still appears once.
+class SemiJoinOperator : public BinaryOperator {
+public:
+    int column_index1;  // The join column index for the first relation
+    int column_index2;  // The join column index for the second relation
+    std::vector<std::pair<int, int>> index1;  // Buckets of rel1, empty for a single bucket
+    std::vector<std::pair<int, int>> index2;  // Buckets of rel2, empty for a single bucket
+
+    SemiJoinOperator(int col_idx1, int col_idx2);
+    SemiJoinOperator(const std::vector<std::pair<int, int>>& idx1, const std::vector<std::pair<int, int>>& idx2, int col_idx1, int col_idx2);
+
+protected:
+    SecureRelation operation(const SecureRelation& rel1, const SecureRelation& rel2) override;
+};
+
+// Definitions
+
+SemiJoinOperator::SemiJoinOperator(int col_idx1, int col_idx2)
+    : column_index1(col_idx1), column_index2(col_idx2) {}
+
+SemiJoinOperator::SemiJoinOperator(const std::vector<std::pair<int, int>>& idx1, const std::vector<std::pair<int, int>>& idx2, int col_idx1, int col_idx2)
+    : column_index1(col_idx1), column_index2(col_idx2), index1(idx1), index2(idx2) {
+    if (idx1.size() != idx2.size()) {
+        throw std::invalid_argument("Semi-join indexes must have the same number of buckets");
+    }
+}
+
+SecureRelation SemiJoinOperator::operation(const SecureRelation& rel1, const SecureRelation& rel2) {
+    int rows1 = rel1.flags.size();
+    int rows2 = rel2.flags.size();
+
+    std::vector<std::pair<int, int>> buckets1 = index1;
+    std::vector<std::pair<int, int>> buckets2 = index2;
+    if (buckets1.empty()) {
+        buckets1.push_back({0, rows1 - 1});
+        buckets2.push_back({0, rows2 - 1});
+    }
+
+    // has_match[r] = some real row of a bucket paired with r's bucket has r's key
+    std::vector<emp::Bit> has_match(rows1, Constants::bit(false));
+    for (size_t b = 0; b < buckets1.size(); b++) {
+        for (int r = buckets1[b].first; r <= buckets1[b].second; r++) {
+            for (int j = buckets2[b].first; j <= buckets2[b].second; j++) {
+                emp::Bit match = (rel1.columns[column_index1][r] == rel2.columns[column_index2][j]) & flag_bit(rel2.flags[j]);
+                has_match[r] = has_match[r] | match;
+            }
+        }
+    }
+
+    SecureRelation result = rel1;
+    for (int r = 0; r < rows1; r++) {
+        result.flags[r] = bit_to_flag(has_match[r] & flag_bit(rel1.flags[r]));
+    }
+    return result;
+}
+
+#endif // SEMIJOIN_OPERATOR_HPP
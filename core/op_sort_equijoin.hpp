@@ -0,0 +1,155 @@
+// sort_equijoin.hpp
+
+#ifndef SORT_EQUIJOIN_OPERATOR_HPP
+#define SORT_EQUIJOIN_OPERATOR_HPP
+
+#include "core/_op_binary.hpp"
+#include "util/public_compare.hpp"
+#include "util/prefix_scan.hpp"
+#include <vector>
+
+// Oblivious sort-merge equijoin. rel1 is the primary-key side: each join key occurs in at
+// most mf1 real rows of rel1 (mf1 = 1 for a PK-FK join). Both inputs are tagged and unioned,
+// sorted on (key, tag) so that rel1 rows precede the rel2 rows with the same key, and a
+// linear scan carries the last rel1 row into the rel2 rows that follow it. The result has
+// the same schema as EquiJoinOperator (rel1 columns, then rel2 columns) and mf1 * |rel2|
+// rows, for O((n+m) log^2 (n+m)) gates per layer instead of O(n*m).
+class SortMergeJoinOperator : public BinaryOperator {
+public:
+    int column_index1;  // The join column index for the first (primary-key) relation
+    int column_index2;  // The join column index for the second relation
+    int mf1;  // Bound on the multiplicity of a key in the first relation
+
+    SortMergeJoinOperator(int col_idx1, int col_idx2, int mf1 = 1);
+
+protected:
+    SecureRelation operation(const SecureRelation& rel1, const SecureRelation& rel2) override;
+
+private:
+    // Join of a rel1 whose real rows have unique keys; returns |rel2| rows
+    SecureRelation pk_fk_join(const SecureRelation& rel1, const SecureRelation& rel2);
+
+    // Split rel1 into mf1 relations whose real rows have unique keys
+    std::vector<SecureRelation> split_layers(const SecureRelation& rel1);
+};
+
+// Definitions
+
+SortMergeJoinOperator::SortMergeJoinOperator(int col_idx1, int col_idx2, int mf1)
+    : column_index1(col_idx1), column_index2(col_idx2), mf1(mf1) {}
+
+SecureRelation SortMergeJoinOperator::operation(const SecureRelation& rel1, const SecureRelation& rel2) {
+    if (mf1 <= 1) {
+        return pk_fk_join(rel1, rel2);
+    }
+
+    std::vector<SecureRelation> layers = split_layers(rel1);
+    int layer_rows = rel2.flags.size();
+    SecureRelation result(rel1.columns.size() + rel2.columns.size(), layer_rows * layers.size());
+    for (size_t l = 0; l < layers.size(); l++) {
+        SecureRelation layer_result = pk_fk_join(layers[l], rel2);
+        for (size_t k = 0; k < result.columns.size(); k++) {
+            std::copy(layer_result.columns[k].begin(), layer_result.columns[k].end(), result.columns[k].begin() + l * layer_rows);
+        }
+        std::copy(layer_result.flags.begin(), layer_result.flags.end(), result.flags.begin() + l * layer_rows);
+    }
+    return result;
+}
+
+SecureRelation SortMergeJoinOperator::pk_fk_join(const SecureRelation& rel1, const SecureRelation& rel2) {
+    int rows1 = rel1.flags.size();
+    int rows2 = rel2.flags.size();
+    int cols1 = rel1.columns.size();
+    int cols2 = rel2.columns.size();
+    int key_col = cols1 + cols2;  // Join key of every row
+    int sort_col = key_col + 1;   // (key, tag) packed as key * 2 + tag
+
+    // Union: rel1 rows carry their columns in [0, cols1), rel2 rows in [cols1, cols1 + cols2)
+    SecureRelation merged(cols1 + cols2 + 2, rows1 + rows2);
+    for (int i = 0; i < rows1 + rows2; i++) {
+        bool from_rel1 = i < rows1;
+        int row = from_rel1 ? i : i - rows1;
+        const SecureRelation& source = from_rel1 ? rel1 : rel2;
+        int offset = from_rel1 ? 0 : cols1;
+
+        for (int k = 0; k < source.columns.size(); k++) {
+            merged.columns[offset + k][i] = source.columns[k][row];
+        }
+        merged.flags[i] = source.flags[row];
+
+        emp::Integer key = source.columns[from_rel1 ? column_index1 : column_index2][row];
+        merged.columns[key_col][i] = key;
+
+        emp::Integer sort_key = key;
+        sort_key.resize(key.size() + 1);
+        for (int b = key.size(); b > 0; b--) {
+            sort_key[b] = sort_key[b - 1];
+        }
+        sort_key[0] = Constants::bit(!from_rel1);
+        merged.columns[sort_col][i] = sort_key;
+    }
+
+    merged.sort_by_column(sort_col);
+
+    // Scan: remember the last real rel1 row and hand its columns to the rel2 rows behind it
+    std::vector<emp::Integer> carry(cols1);
+    for (int k = 0; k < cols1; k++) {
+        carry[k] = Constants::zero(merged.columns[k][0].size());
+    }
+    emp::Integer carry_key = Constants::zero(merged.columns[key_col][0].size());
+    emp::Bit carry_valid = Constants::bit(false);
+
+    for (int i = 0; i < rows1 + rows2; i++) {
+        emp::Bit from_rel2 = merged.columns[sort_col][i][0];
+        emp::Bit real = flag_bit(merged.flags[i]);
+        emp::Bit update = (!from_rel2) & real;
+
+        for (int k = 0; k < cols1; k++) {
+            carry[k] = emp::If(update, merged.columns[k][i], carry[k]);
+            merged.columns[k][i] = carry[k];
+        }
+        carry_key = emp::If(update, merged.columns[key_col][i], carry_key);
+        carry_valid = carry_valid | update;
+
+        emp::Bit match = from_rel2 & real & carry_valid & (carry_key == merged.columns[key_col][i]);
+        merged.flags[i] = bit_to_flag(match);
+    }
+
+    // Every rel2 row matches at most one rel1 row
+    merged.compact_stable(rows2);
+    merged.columns.resize(cols1 + cols2);
+    for (auto& column : merged.columns) {
+        column.resize(rows2, Constants::zero());
+    }
+    merged.flags.resize(rows2, Constants::flag(false));
+
+    return merged;
+}
+
+std::vector<SecureRelation> SortMergeJoinOperator::split_layers(const SecureRelation& rel1) {
+    SecureRelation sorted = rel1;
+    sorted.sort_by_column(column_index1);
+
+    int rows = sorted.flags.size();
+    std::vector<emp::Integer> rank(rows, Constants::zero());
+
+    // rank[i] = number of real rows with the same key in front of row i: a segmented prefix
+    // sum over the key runs of the previous row's flag, which is 0 at the head of a run
+    std::vector<emp::Bit> heads(rows, Constants::bit(true));
+    for (int i = 1; i < rows; i++) {
+        heads[i] = sorted.columns[column_index1][i] != sorted.columns[column_index1][i - 1];
+        rank[i][0] = flag_bit(sorted.flags[i - 1]) & !heads[i];
+    }
+    PrefixScan::segmented_scan(rank, heads, PrefixScan::add);
+
+    std::vector<SecureRelation> layers(mf1, sorted);
+    for (int l = 0; l < mf1; l++) {
+        for (int i = 0; i < rows; i++) {
+            emp::Bit keep = flag_bit(sorted.flags[i]) & PublicCompare::equal(rank[i], l);
+            layers[l].flags[i] = bit_to_flag(keep);
+        }
+    }
+    return layers;
+}
+
+#endif // SORT_EQUIJOIN_OPERATOR_HPP
@@ -0,0 +1,170 @@
+// star_join.hpp
+
+#ifndef STAR_JOIN_OPERATOR_HPP
+#define STAR_JOIN_OPERATOR_HPP
+
+#include "core/_op_nary.hpp"
+#include "core/op_tiled_equijoin.hpp"
+#include "core/strip_layout.hpp"
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+
+// Multi-way equijoin of N relations on a common key (e.g. account_id). Every input is
+// sorted on its key and comes with a DP index whose i-th range covers the same key range
+// as the i-th range of the other indexes. Bucket i of all inputs is joined in one go:
+// the bucket rows are folded left to right, and after each step the partial result is
+// compacted to the MF bound of the inputs joined so far, so neither a pairwise
+// intermediate of the whole relations nor a rebuilt index is ever needed.
+// Noisy ranges of neighbouring buckets overlap, so the buckets are cut into cells of one
+// strip per input and every cell is joined by the one bucket owning it (see StripLayout);
+// a row combination in an overlap is never joined, and its matches never emitted, twice.
+// The result has the columns of all inputs in input order, one range per bucket.
+class StarJoinOperator : public NaryOperator {
+public:
+    std::vector<std::vector<std::pair<int, int>>> indexes;  // DP index of every input
+    std::vector<int> column_indexes;  // Join column of every input
+    std::vector<int> mfs;  // Maximum frequency of a key in every input
+
+    StarJoinOperator(const std::vector<std::vector<std::pair<int, int>>>& indexes, const std::vector<int>& col_indexes, const std::vector<int>& mfs);
+
+    // Index of the result: one range per bucket, sized by the MF bound of the full join over its cells
+    std::vector<std::pair<int, int>> rebuild_index();
+
+protected:
+    SecureRelation operation(const std::vector<SecureRelation>& inputs) override;
+
+private:
+    // Rows of rel in the inclusive range
+    SecureRelation bucketize(const SecureRelation& rel, const std::pair<int, int>& range);
+
+    // Bound on the join of the first count inputs, given the rows taken from every input
+    int join_bound(const std::vector<int>& sizes, int count);
+
+    // Rows of every input in one cell of the layout
+    std::vector<int> cell_sizes(const StripLayout& layout, const std::vector<int>& cell);
+
+    // Rows kept for one bucket: the bound over the rows it covers, capped by the bounds of its cells
+    int bucket_size(const StripLayout& layout, size_t bucket);
+};
+
+// Implementations
+
+StarJoinOperator::StarJoinOperator(const std::vector<std::vector<std::pair<int, int>>>& indexes, const std::vector<int>& col_indexes, const std::vector<int>& mfs)
+    : indexes(indexes), column_indexes(col_indexes), mfs(mfs) {
+    if (indexes.size() < 2) {
+        throw std::invalid_argument("Star join needs at least two inputs");
+    }
+    if (col_indexes.size() != indexes.size() || mfs.size() != indexes.size()) {
+        throw std::invalid_argument("Star join needs one join column and one MF per input");
+    }
+    for (const auto& index : indexes) {
+        if (index.size() != indexes[0].size()) {
+            throw std::invalid_argument("Star join indexes must have the same number of buckets");
+        }
+    }
+}
+
+SecureRelation StarJoinOperator::operation(const std::vector<SecureRelation>& inputs) {
+    if (inputs.size() != indexes.size()) {
+        throw std::invalid_argument("Star join expects " + std::to_string(indexes.size()) + " inputs");
+    }
+
+    int result_cols = 0;
+    for (const auto& input : inputs) {
+        result_cols += input.columns.size();
+    }
+
+    StripLayout layout(indexes);
+    std::vector<std::pair<int, int>> result_index = rebuild_index();
+    SecureRelation result(result_cols, result_index.empty() ? 0 : result_index.back().second + 1);
+
+    for (size_t b = 0; b < indexes[0].size(); b++) {
+        int output_size = result_index[b].second - result_index[b].first + 1;
+        SecureRelation buffer(result_cols, 0);
+        for (const auto& cell : layout.cells[b]) {
+            // Fold the strips of the cell; the key of the partial result stays in the columns of input 0
+            std::vector<int> sizes = cell_sizes(layout, cell);
+            SecureRelation partial = bucketize(inputs[0], layout.strips[0][cell[0]]);
+            for (size_t k = 1; k < inputs.size(); k++) {
+                SecureRelation strip = bucketize(inputs[k], layout.strips[k][cell[k]]);
+                TiledEquiJoinOperator join_op(column_indexes[0], column_indexes[k], join_bound(sizes, k + 1));
+                partial = join_op.execute(partial, strip);
+            }
+            buffer.append_and_compact(partial, output_size);
+        }
+
+        int offset = result_index[b].first;
+        for (int k = 0; k < result_cols; k++) {
+            std::move(buffer.columns[k].begin(), buffer.columns[k].end(), result.columns[k].begin() + offset);
+        }
+        std::move(buffer.flags.begin(), buffer.flags.end(), result.flags.begin() + offset);
+    }
+
+    return result;
+}
+
+SecureRelation StarJoinOperator::bucketize(const SecureRelation& rel, const std::pair<int, int>& range) {
+    int bucket_size = range.second - range.first + 1;
+    SecureRelation bucket(rel.columns.size(), bucket_size);
+    for (size_t col = 0; col < rel.columns.size(); col++) {
+        for (int row = range.first; row <= range.second; row++) {
+            bucket.columns[col][row - range.first] = rel.columns[col][row];
+        }
+    }
+    for (int row = range.first; row <= range.second; row++) {
+        bucket.flags[row - range.first] = rel.flags[row];
+    }
+    return bucket;
+}
+
+// A key joins at most mf_j rows of every other input, so the join of inputs 0..count-1
+// has at most |b_i| * prod_{j != i} mf_j rows for every i, and never more than prod |b_i|.
+int StarJoinOperator::join_bound(const std::vector<int>& sizes, int count) {
+    long long cross = 1;
+    for (int k = 0; k < count; k++) {
+        cross *= sizes[k];
+    }
+
+    long long bound = cross;
+    for (int i = 0; i < count; i++) {
+        long long candidate = sizes[i];
+        for (int j = 0; j < count; j++) {
+            if (j != i) candidate *= mfs[j];
+        }
+        bound = std::min(bound, candidate);
+    }
+    return static_cast<int>(bound);
+}
+
+std::vector<int> StarJoinOperator::cell_sizes(const StripLayout& layout, const std::vector<int>& cell) {
+    std::vector<int> sizes(cell.size());
+    for (size_t k = 0; k < cell.size(); k++) {
+        sizes[k] = layout.rows(k, cell[k]);
+    }
+    return sizes;
+}
+
+int StarJoinOperator::bucket_size(const StripLayout& layout, size_t bucket) {
+    long long cells_bound = 0;
+    for (const auto& cell : layout.cells[bucket]) {
+        cells_bound += join_bound(cell_sizes(layout, cell), indexes.size());
+    }
+    return static_cast<int>(std::min<long long>(join_bound(layout.covered_rows(bucket), indexes.size()), cells_bound));
+}
+
+std::vector<std::pair<int, int>> StarJoinOperator::rebuild_index() {
+    StripLayout layout(indexes);
+    std::vector<std::pair<int, int>> new_index;
+    int start_idx = 0;
+    for (size_t b = 0; b < indexes[0].size(); b++) {
+        int end_idx = start_idx + bucket_size(layout, b) - 1;
+        new_index.push_back({start_idx, end_idx});
+        start_idx = end_idx + 1;
+    }
+    return new_index;
+}
+
+#endif // STAR_JOIN_OPERATOR_HPP
@@ -0,0 +1,83 @@
+// tiled_equijoin.hpp
+
+#ifndef TILED_EQUIJOIN_OPERATOR_HPP
+#define TILED_EQUIJOIN_OPERATOR_HPP
+
+#include "core/_op_binary.hpp"
+#include "core/join_key.hpp"
+#include <algorithm>
+#include <vector>
+
+// Nested-loop equijoin that never materializes rel1 x rel2. Row pairs are produced in
+// tiles of tile_size rows, each tile is appended to a running buffer of matches, and the
+// buffer is compacted back to output_size whenever it outgrows it. Peak memory is
+// O(output_size + tile_size) rows, and compaction of one tile overlaps with the join of
+// the next instead of sorting the whole cross product at the end. The result has the
+// schema of EquiJoinOperator, exactly output_size rows, and the real rows in
+// row-major (rel1, rel2) order, packed to the front once the pairs outnumber output_size.
+class TiledEquiJoinOperator : public BinaryOperator {
+public:
+    JoinKey key1;       // The join key of the first relation
+    JoinKey key2;       // The join key of the second relation
+    int output_size;    // Number of rows kept after compaction
+    int tile_size;      // Row pairs produced between two compactions
+
+    // tile_size = 0 uses output_size, which balances join and compaction work
+    TiledEquiJoinOperator(const JoinKey& key1, const JoinKey& key2, int output_size, int tile_size = 0);
+
+protected:
+    SecureRelation operation(const SecureRelation& rel1, const SecureRelation& rel2) override;
+};
+
+// Definitions
+
+TiledEquiJoinOperator::TiledEquiJoinOperator(const JoinKey& key1, const JoinKey& key2, int output_size, int tile_size)
+    : key1(key1), key2(key2), output_size(output_size), tile_size(tile_size) {
+    JoinKey::check_compatible(key1, key2);
+}
+
+SecureRelation TiledEquiJoinOperator::operation(const SecureRelation& rel1, const SecureRelation& rel2) {
+    int rows1 = rel1.flags.size();
+    int rows2 = rel2.flags.size();
+    int cols1 = rel1.columns.size();
+    int cols2 = rel2.columns.size();
+    long long total_pairs = static_cast<long long>(rows1) * rows2;
+    int tile = tile_size > 0 ? tile_size : std::max(output_size, 1);
+    std::vector<emp::Integer> keys1 = key1.pack(rel1);
+    std::vector<emp::Integer> keys2 = key2.pack(rel2);
+
+    SecureRelation buffer(cols1 + cols2, 0);
+    for (long long begin = 0; begin < total_pairs; begin += tile) {
+        long long end = std::min(total_pairs, begin + tile);
+
+        // The next tile of row pairs with their join flags
+        SecureRelation pairs(cols1 + cols2, end - begin);
+        for (long long pair = begin; pair < end; pair++) {
+            int i = pair / rows2;
+            int j = pair % rows2;
+            int row = pair - begin;
+            for (int k = 0; k < cols1; k++) {
+                pairs.columns[k][row] = rel1.columns[k][i];
+            }
+            for (int k = 0; k < cols2; k++) {
+                pairs.columns[cols1 + k][row] = rel2.columns[k][j];
+            }
+            emp::Bit join_condition = (keys1[i] == keys2[j]) & flag_bit(rel1.flags[i]) & flag_bit(rel2.flags[j]);
+            pairs.flags[row] = bit_to_flag(join_condition);
+        }
+
+        // Shrink back to the output size, keeping the matches found so far
+        buffer.append_and_compact(pairs, output_size);
+    }
+    if (total_pairs == 0) {
+        // No pairs at all: only dummy rows
+        buffer.append_and_compact(SecureRelation(cols1 + cols2, 0), output_size);
+    }
+
+    // The real rows stay in rel1-major order, so an order of rel1 carries over
+    buffer.sorted_column = rel1.sorted_column;
+
+    return buffer;
+}
+
+#endif // TILED_EQUIJOIN_OPERATOR_HPP
@@ -0,0 +1,327 @@
+// predicate.hpp
+
+#ifndef PREDICATE_HPP
+#define PREDICATE_HPP
+
+#include "core/relation.hpp"
+#include "util/public_compare.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Comparison operators supported by predicate leaves
+enum class CompareOp { GT, GEQ, LT, LEQ, EQ, NEQ };
+
+// Translate a condition string ("gt", "geq", "lt", "leq", "eq", "neq") into a CompareOp
+CompareOp parse_compare_op(const std::string& condition);
+
+class Predicate {
+public:
+    // A compiled predicate maps (relation, row) to the secret bit "row satisfies the predicate"
+    typedef std::function<emp::Bit(const SecureRelation&, int)> Compiled;
+
+    enum NodeType {
+        COLUMN_VALUE,   // column <op> constant
+        COLUMN_COLUMN,  // column <op> another column of the same relation
+        COLUMN_VECTOR,  // column <op> an external column (one value per row)
+        BETWEEN,        // lower <= column <= upper
+        IN_LIST,        // column IN (v1, v2, ...)
+        AND,
+        OR,
+        NOT
+    };
+
+    // Leaves
+    static Predicate compare(int col_idx, CompareOp op, const emp::Integer& value);
+    static Predicate compare_columns(int col_idx, CompareOp op, int other_col_idx);
+    static Predicate compare_vector(int col_idx, CompareOp op, const std::vector<emp::Integer>& target_col);
+    static Predicate between(int col_idx, const emp::Integer& lower, const emp::Integer& upper);
+    static Predicate in_list(int col_idx, const std::vector<emp::Integer>& values);
+
+    // Leaves against public constants; these compile to the reduced circuits in util/public_compare.hpp
+    static Predicate compare(int col_idx, CompareOp op, int64_t value);
+    static Predicate between(int col_idx, int64_t lower, int64_t upper);
+    static Predicate in_list(int col_idx, const std::vector<int64_t>& values);
+
+    // Connectives
+    Predicate operator&&(const Predicate& other) const;
+    Predicate operator||(const Predicate& other) const;
+    Predicate operator!() const;
+
+    // Resolve every operator once and return a callable that evaluates the whole tree per row
+    Compiled compile() const;
+
+private:
+    struct Node {
+        NodeType type;
+        int column_index = -1;
+        int other_column_index = -1;
+        CompareOp op = CompareOp::EQ;
+        std::vector<emp::Integer> values;  // constant, [lower, upper], IN-list or external column
+        std::vector<int64_t> constants;    // same roles as values, when the constants are public
+        bool public_constants = false;
+        std::shared_ptr<const Node> left;
+        std::shared_ptr<const Node> right;
+    };
+
+    std::shared_ptr<const Node> root;
+
+    explicit Predicate(std::shared_ptr<const Node> node) : root(node) {}
+
+    static Compiled compile_node(const std::shared_ptr<const Node>& node);
+    static Compiled compile_public(const std::shared_ptr<const Node>& node);
+};
+
+// Definitions
+
+CompareOp parse_compare_op(const std::string& condition) {
+    if (condition == "gt") return CompareOp::GT;
+    if (condition == "geq") return CompareOp::GEQ;
+    if (condition == "lt") return CompareOp::LT;
+    if (condition == "leq") return CompareOp::LEQ;
+    if (condition == "eq") return CompareOp::EQ;
+    if (condition == "neq") return CompareOp::NEQ;
+    throw std::invalid_argument("Unsupported filter condition " + condition);
+}
+
+namespace {
+    typedef emp::Bit (*Comparator)(const emp::Integer&, const emp::Integer&);
+
+    emp::Bit cmp_gt(const emp::Integer& a, const emp::Integer& b) { return a > b; }
+    emp::Bit cmp_geq(const emp::Integer& a, const emp::Integer& b) { return a >= b; }
+    emp::Bit cmp_lt(const emp::Integer& a, const emp::Integer& b) { return a < b; }
+    emp::Bit cmp_leq(const emp::Integer& a, const emp::Integer& b) { return a <= b; }
+    emp::Bit cmp_eq(const emp::Integer& a, const emp::Integer& b) { return a == b; }
+    emp::Bit cmp_neq(const emp::Integer& a, const emp::Integer& b) { return a != b; }
+
+    Comparator comparator_for(CompareOp op) {
+        switch (op) {
+            case CompareOp::GT: return cmp_gt;
+            case CompareOp::GEQ: return cmp_geq;
+            case CompareOp::LT: return cmp_lt;
+            case CompareOp::LEQ: return cmp_leq;
+            case CompareOp::EQ: return cmp_eq;
+            default: return cmp_neq;
+        }
+    }
+}
+
+Predicate Predicate::compare(int col_idx, CompareOp op, const emp::Integer& value) {
+    std::shared_ptr<Node> node(new Node());
+    node->type = COLUMN_VALUE;
+    node->column_index = col_idx;
+    node->op = op;
+    node->values.push_back(value);
+    return Predicate(node);
+}
+
+Predicate Predicate::compare_columns(int col_idx, CompareOp op, int other_col_idx) {
+    std::shared_ptr<Node> node(new Node());
+    node->type = COLUMN_COLUMN;
+    node->column_index = col_idx;
+    node->other_column_index = other_col_idx;
+    node->op = op;
+    return Predicate(node);
+}
+
+Predicate Predicate::compare_vector(int col_idx, CompareOp op, const std::vector<emp::Integer>& target_col) {
+    std::shared_ptr<Node> node(new Node());
+    node->type = COLUMN_VECTOR;
+    node->column_index = col_idx;
+    node->op = op;
+    node->values = target_col;
+    return Predicate(node);
+}
+
+Predicate Predicate::between(int col_idx, const emp::Integer& lower, const emp::Integer& upper) {
+    std::shared_ptr<Node> node(new Node());
+    node->type = BETWEEN;
+    node->column_index = col_idx;
+    node->values.push_back(lower);
+    node->values.push_back(upper);
+    return Predicate(node);
+}
+
+Predicate Predicate::in_list(int col_idx, const std::vector<emp::Integer>& values) {
+    if (values.empty()) {
+        throw std::invalid_argument("IN-list predicate needs at least one value");
+    }
+    std::shared_ptr<Node> node(new Node());
+    node->type = IN_LIST;
+    node->column_index = col_idx;
+    node->values = values;
+    return Predicate(node);
+}
+
+Predicate Predicate::compare(int col_idx, CompareOp op, int64_t value) {
+    std::shared_ptr<Node> node(new Node());
+    node->type = COLUMN_VALUE;
+    node->column_index = col_idx;
+    node->op = op;
+    node->constants.push_back(value);
+    node->public_constants = true;
+    return Predicate(node);
+}
+
+Predicate Predicate::between(int col_idx, int64_t lower, int64_t upper) {
+    std::shared_ptr<Node> node(new Node());
+    node->type = BETWEEN;
+    node->column_index = col_idx;
+    node->constants.push_back(lower);
+    node->constants.push_back(upper);
+    node->public_constants = true;
+    return Predicate(node);
+}
+
+Predicate Predicate::in_list(int col_idx, const std::vector<int64_t>& values) {
+    if (values.empty()) {
+        throw std::invalid_argument("IN-list predicate needs at least one value");
+    }
+    std::shared_ptr<Node> node(new Node());
+    node->type = IN_LIST;
+    node->column_index = col_idx;
+    node->constants = values;
+    node->public_constants = true;
+    return Predicate(node);
+}
+
+Predicate Predicate::operator&&(const Predicate& other) const {
+    std::shared_ptr<Node> node(new Node());
+    node->type = AND;
+    node->left = root;
+    node->right = other.root;
+    return Predicate(node);
+}
+
+Predicate Predicate::operator||(const Predicate& other) const {
+    std::shared_ptr<Node> node(new Node());
+    node->type = OR;
+    node->left = root;
+    node->right = other.root;
+    return Predicate(node);
+}
+
+Predicate Predicate::operator!() const {
+    std::shared_ptr<Node> node(new Node());
+    node->type = NOT;
+    node->left = root;
+    return Predicate(node);
+}
+
+Predicate::Compiled Predicate::compile() const {
+    return compile_node(root);
+}
+
+Predicate::Compiled Predicate::compile_node(const std::shared_ptr<const Node>& node) {
+    int col = node->column_index;
+
+    if (node->public_constants) {
+        return compile_public(node);
+    }
+
+    switch (node->type) {
+        case COLUMN_VALUE: {
+            Comparator cmp = comparator_for(node->op);
+            emp::Integer value = node->values[0];
+            return [cmp, col, value](const SecureRelation& rel, int row) {
+                return cmp(rel.columns[col][row], value);
+            };
+        }
+        case COLUMN_COLUMN: {
+            Comparator cmp = comparator_for(node->op);
+            int other = node->other_column_index;
+            return [cmp, col, other](const SecureRelation& rel, int row) {
+                return cmp(rel.columns[col][row], rel.columns[other][row]);
+            };
+        }
+        case COLUMN_VECTOR: {
+            Comparator cmp = comparator_for(node->op);
+            return [cmp, col, node](const SecureRelation& rel, int row) {
+                return cmp(rel.columns[col][row], node->values[row]);
+            };
+        }
+        case BETWEEN: {
+            emp::Integer lower = node->values[0];
+            emp::Integer upper = node->values[1];
+            return [col, lower, upper](const SecureRelation& rel, int row) {
+                const emp::Integer& v = rel.columns[col][row];
+                return (v >= lower) & (v <= upper);
+            };
+        }
+        case IN_LIST: {
+            return [col, node](const SecureRelation& rel, int row) {
+                const emp::Integer& v = rel.columns[col][row];
+                emp::Bit hit = (v == node->values[0]);
+                for (size_t k = 1; k < node->values.size(); k++) {
+                    hit = hit | (v == node->values[k]);
+                }
+                return hit;
+            };
+        }
+        case AND: {
+            Compiled lhs = compile_node(node->left);
+            Compiled rhs = compile_node(node->right);
+            return [lhs, rhs](const SecureRelation& rel, int row) {
+                return lhs(rel, row) & rhs(rel, row);
+            };
+        }
+        case OR: {
+            Compiled lhs = compile_node(node->left);
+            Compiled rhs = compile_node(node->right);
+            return [lhs, rhs](const SecureRelation& rel, int row) {
+                return lhs(rel, row) | rhs(rel, row);
+            };
+        }
+        default: {
+            Compiled inner = compile_node(node->left);
+            return [inner](const SecureRelation& rel, int row) {
+                return !inner(rel, row);
+            };
+        }
+    }
+}
+
+Predicate::Compiled Predicate::compile_public(const std::shared_ptr<const Node>& node) {
+    int col = node->column_index;
+
+    switch (node->type) {
+        case COLUMN_VALUE: {
+            CompareOp op = node->op;
+            int64_t c = node->constants[0];
+            return [op, col, c](const SecureRelation& rel, int row) {
+                const emp::Integer& v = rel.columns[col][row];
+                switch (op) {
+                    case CompareOp::GT: return !PublicCompare::less_than(v, c, true);
+                    case CompareOp::GEQ: return !PublicCompare::less_than(v, c);
+                    case CompareOp::LT: return PublicCompare::less_than(v, c);
+                    case CompareOp::LEQ: return PublicCompare::less_than(v, c, true);
+                    case CompareOp::EQ: return PublicCompare::equal(v, c);
+                    default: return !PublicCompare::equal(v, c);
+                }
+            };
+        }
+        case BETWEEN: {
+            int64_t lower = node->constants[0];
+            int64_t upper = node->constants[1];
+            return [col, lower, upper](const SecureRelation& rel, int row) {
+                const emp::Integer& v = rel.columns[col][row];
+                return (!PublicCompare::less_than(v, lower)) & PublicCompare::less_than(v, upper, true);
+            };
+        }
+        default: {
+            return [col, node](const SecureRelation& rel, int row) {
+                const emp::Integer& v = rel.columns[col][row];
+                emp::Bit hit = PublicCompare::equal(v, node->constants[0]);
+                for (size_t k = 1; k < node->constants.size(); k++) {
+                    hit = hit | PublicCompare::equal(v, node->constants[k]);
+                }
+                return hit;
+            };
+        }
+    }
+}
+
+#endif // PREDICATE_HPP
@@ -4,6 +4,8 @@
 #define RELATION_HPP
 
 #include "emp-sh2pc/emp-sh2pc.h"
+#include "util/constants.hpp"
+#include "util/prefix_scan.hpp"
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -15,6 +17,11 @@ public:
     std::vector<std::vector<emp::Integer>> columns;
     std::vector<emp::Integer> flags;
 
+    // Column the real rows are known to be in ascending order on, -1 if unknown. Sorting on a
+    // column sets it, reordering by flag clears it; changing flags and compact_stable keep it.
+    // Operators may rely on no row with another key lying between two real rows with equal keys.
+    int sorted_column = -1;
+
     // Constructor to initialize the relation with specified column count and row count
     SecureRelation() : SecureRelation(0, 0) {} // Default constructor
     SecureRelation(int column_count, int row_count);
@@ -37,15 +44,26 @@ public:
     // The compact function
     void compact(int K);
 
+    // Order-preserving compaction to K rows in O(n log n)
+    void compact_stable(int K);
+
+    // Append the rows of tile, compact stably back to K rows when there are more, and pad
+    // to exactly K rows with dummies; the running buffer of the tiled operators
+    void append_and_compact(const SecureRelation& tile, int K);
+
     // Utility function to print the relation's details
     void print_relation(const std::string& label) const;
 };
 
+// Conversions between the 1-bit Integer flags and emp::Bit
+emp::Bit flag_bit(const emp::Integer& flag);
+emp::Integer bit_to_flag(const emp::Bit& bit);
+
 // Implementations
 
 SecureRelation::SecureRelation(int column_count, int row_count) {
-    columns.resize(column_count, std::vector<emp::Integer>(row_count, emp::Integer(32, 0, emp::PUBLIC)));
-    flags.resize(row_count, emp::Integer(1, 1, emp::PUBLIC));
+    columns.resize(column_count, std::vector<emp::Integer>(row_count, Constants::zero()));
+    flags.resize(row_count, Constants::flag(true));
 }
 
 void SecureRelation::sort_by_column(int column_index) {
@@ -54,32 +72,39 @@ void SecureRelation::sort_by_column(int column_index) {
         return;
     }
     bitonic_sort(0, flags.size(), true, columns[column_index]);
+    sorted_column = column_index;
 }
 
 void SecureRelation::sort_by_flag() {
     bitonic_sort(0, flags.size(), true, flags);
+    sorted_column = -1;
 }
 
+// Bitonic sort of the high rows starting at low; works for any row count, not only powers of two
 void SecureRelation::bitonic_sort(int low, int high, bool ascending, std::vector<emp::Integer>& key_column) {
     if (high <= 1) return;
 
     int mid = high / 2;
-    bitonic_sort(low, mid, true, key_column);
-    bitonic_sort(low + mid, mid, false, key_column);
+    bitonic_sort(low, mid, !ascending, key_column);
+    bitonic_sort(low + mid, high - mid, ascending, key_column);
     bitonic_merge(low, high, ascending, key_column);
 }
 
 void SecureRelation::bitonic_merge(int low, int high, bool ascending, std::vector<emp::Integer>& key_column) {
     if (high <= 1) return;
 
-    int mid = high / 2;
-    for (int i = low; i < low + mid; i++) {
+    // Greatest power of two less than high
+    int mid = 1;
+    while (mid < high) mid <<= 1;
+    mid >>= 1;
+
+    for (int i = low; i < low + high - mid; i++) {
         emp::Bit condition = (key_column[i] > key_column[i+mid]) == ascending;
         swap_rows(i, i+mid, condition);
     }
 
     bitonic_merge(low, mid, ascending, key_column);
-    bitonic_merge(low + mid, mid, ascending, key_column);
+    bitonic_merge(low + mid, high - mid, ascending, key_column);
 }
 
 void SecureRelation::swap_rows(int i, int j, emp::Bit condition) {
@@ -98,6 +123,7 @@ void SecureRelation::swap_rows(int i, int j, emp::Bit condition) {
 
 void SecureRelation::sort_by_flag_goldreich() {
     goldreich_compaction(0, flags.size());
+    sorted_column = -1;
 }
 
 void SecureRelation::goldreich_compaction(int low, int high) {
@@ -153,6 +179,63 @@ void SecureRelation::compact(int K) {
     }
 }
 
+// Order-preserving compaction: real rows move to the front without changing their relative
+// order, then the relation is truncated to K rows. Every real row has to move left by the
+// number of dummies in front of it; level j of the network moves rows whose remaining
+// distance has bit j set by 2^j. Rows are visited in ascending order, so the target slot is
+// always a dummy or a row that already left during the same level.
+void SecureRelation::compact_stable(int K) {
+    int n = flags.size();
+    if (n == 0) return;
+
+    int width = 1;
+    while ((1 << width) <= n) width++;
+
+    // distance[i] = number of dummy rows before row i, as a log-depth prefix sum
+    std::vector<emp::Integer> distance(n, Constants::zero(width));
+    for (int i = 1; i < n; i++) {
+        distance[i][0] = !flag_bit(flags[i - 1]);
+    }
+    PrefixScan::inclusive_scan(distance, PrefixScan::add);
+
+    for (int level = 0; (1 << level) < n; level++) {
+        int step = 1 << level;
+        for (int i = step; i < n; i++) {
+            int dest = i - step;
+            emp::Bit move = flag_bit(flags[i]) & distance[i][level];
+
+            for (auto& column : columns) {
+                column[dest] = emp::If(move, column[i], column[dest]);
+            }
+            distance[dest] = emp::If(move, distance[i], distance[dest]);
+            flags[dest] = emp::If(move, flags[i], flags[dest]);
+            flags[i] = bit_to_flag(flag_bit(flags[i]) & !move);
+        }
+    }
+
+    if (n > K) {
+        for (auto& column : columns) {
+            column.resize(K);
+        }
+        flags.resize(K);
+    }
+}
+
+void SecureRelation::append_and_compact(const SecureRelation& tile, int K) {
+    for (size_t k = 0; k < columns.size(); k++) {
+        columns[k].insert(columns[k].end(), tile.columns[k].begin(), tile.columns[k].end());
+    }
+    flags.insert(flags.end(), tile.flags.begin(), tile.flags.end());
+
+    if (static_cast<int>(flags.size()) > K) {
+        compact_stable(K);
+    }
+    for (auto& column : columns) {
+        column.resize(K, Constants::zero());
+    }
+    flags.resize(K, Constants::flag(false));
+}
+
 // Helper function 
 void SecureRelation::print_relation(const std::string& label) const {
     std::cout << label << "\n";
@@ -165,4 +248,14 @@ void SecureRelation::print_relation(const std::string& label) const {
     std::cout << "\n";
 }
 
+emp::Bit flag_bit(const emp::Integer& flag) {
+    return flag[0];
+}
+
+emp::Integer bit_to_flag(const emp::Bit& bit) {
+    emp::Integer flag;
+    flag.bits.push_back(bit);
+    return flag;
+}
+
 #endif // RELATION_HPP
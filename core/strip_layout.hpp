@@ -0,0 +1,136 @@
+// strip_layout.hpp
+
+#ifndef STRIP_LAYOUT_HPP
+#define STRIP_LAYOUT_HPP
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+// Ownership of row combinations under overlapping DP indexes. The noisy ranges of
+// neighbouring buckets overlap, so a combination of rows in the overlap is covered by
+// several buckets, and joining every bucket on its own would produce its matches once per
+// covering bucket. The rows of every input are cut into disjoint strips at every range
+// boundary; a range then covers a contiguous run of strips. A cell is one strip per input,
+// and every cell is owned by the first bucket covering all of its strips, so each row
+// combination is joined exactly once. A bucket may own no cell at all.
+class StripLayout {
+public:
+    std::vector<std::vector<std::pair<int, int>>> strips;  // Disjoint strips of every input
+    std::vector<std::vector<std::vector<int>>> cells;  // Cells owned by every bucket, one strip per input
+
+    StripLayout() {}
+
+    // indexes[k][b] is the range of bucket b in input k; empty ranges (first > second) cover nothing
+    StripLayout(const std::vector<std::vector<std::pair<int, int>>>& indexes);
+
+    // Number of rows of a strip of an input
+    int rows(int input, int strip) const;
+
+    // Number of row combinations of a cell
+    long long cell_size(const std::vector<int>& cell) const;
+
+    // Rows of every input covered by the cells of bucket b, counting each strip once
+    std::vector<int> covered_rows(size_t b) const;
+
+private:
+    // Cut the rows covered by an index at every range boundary
+    static std::vector<std::pair<int, int>> cut(const std::vector<std::pair<int, int>>& index);
+
+    // Strips [first, second) of an input inside a range
+    std::pair<int, int> covered(int input, const std::pair<int, int>& range) const;
+};
+
+// Implementations
+
+StripLayout::StripLayout(const std::vector<std::vector<std::pair<int, int>>>& indexes) {
+    size_t inputs = indexes.size();
+    size_t buckets = inputs == 0 ? 0 : indexes[0].size();
+    for (const auto& index : indexes) {
+        strips.push_back(cut(index));
+    }
+    cells.resize(buckets);
+
+    std::set<std::vector<int>> owned;
+    for (size_t b = 0; b < buckets; b++) {
+        std::vector<std::pair<int, int>> runs(inputs);
+        bool empty = false;
+        for (size_t k = 0; k < inputs; k++) {
+            runs[k] = covered(k, indexes[k][b]);
+            empty = empty || runs[k].first >= runs[k].second;
+        }
+        if (empty) continue;
+
+        // Every combination of one covered strip per input, the last input varying fastest
+        std::vector<int> cell(inputs);
+        for (size_t k = 0; k < inputs; k++) cell[k] = runs[k].first;
+        while (true) {
+            if (owned.insert(cell).second) {
+                cells[b].push_back(cell);
+            }
+            int k = inputs - 1;
+            while (k >= 0 && ++cell[k] == runs[k].second) {
+                cell[k] = runs[k].first;
+                k--;
+            }
+            if (k < 0) break;
+        }
+    }
+}
+
+int StripLayout::rows(int input, int strip) const {
+    return strips[input][strip].second - strips[input][strip].first + 1;
+}
+
+long long StripLayout::cell_size(const std::vector<int>& cell) const {
+    long long size = 1;
+    for (size_t k = 0; k < cell.size(); k++) {
+        size *= rows(k, cell[k]);
+    }
+    return size;
+}
+
+std::vector<int> StripLayout::covered_rows(size_t b) const {
+    std::vector<int> result(strips.size(), 0);
+    for (size_t k = 0; k < strips.size(); k++) {
+        std::vector<int> ids;
+        for (const auto& cell : cells[b]) {
+            ids.push_back(cell[k]);
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        for (int id : ids) {
+            result[k] += rows(k, id);
+        }
+    }
+    return result;
+}
+
+std::vector<std::pair<int, int>> StripLayout::cut(const std::vector<std::pair<int, int>>& index) {
+    std::vector<int> cuts;
+    for (const auto& range : index) {
+        if (range.first > range.second) continue;
+        cuts.push_back(range.first);
+        cuts.push_back(range.second + 1);
+    }
+    std::sort(cuts.begin(), cuts.end());
+    cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+    std::vector<std::pair<int, int>> result;
+    for (size_t k = 0; k + 1 < cuts.size(); k++) {
+        result.push_back({cuts[k], cuts[k + 1] - 1});
+    }
+    return result;
+}
+
+// Strips never straddle a range boundary, so a range covers a contiguous run of strips
+std::pair<int, int> StripLayout::covered(int input, const std::pair<int, int>& range) const {
+    if (range.first > range.second) return {0, 0};
+    const std::vector<std::pair<int, int>>& s = strips[input];
+    auto first = std::lower_bound(s.begin(), s.end(), std::make_pair(range.first, range.first));
+    auto last = std::upper_bound(s.begin(), s.end(), std::make_pair(range.second, range.second));
+    return std::make_pair(static_cast<int>(first - s.begin()), static_cast<int>(last - s.begin()));
+}
+
+#endif // STRIP_LAYOUT_HPP
@@ -0,0 +1,72 @@
+// synopsis.hpp
+
+#ifndef SYNOPSIS_HPP
+#define SYNOPSIS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Differentially private synopsis of a relation, as generated by synopsis/gen_synop.py.
+// Every field is already noised, so operators may use it to pick public sizes.
+class Synopsis {
+public:
+    int noisy_count;  // Noisy upper bound on the number of qualifying rows
+    std::vector<std::pair<int, int>> index;  // Noisy CDF index: row range of each bucket
+    int max_frequency;  // Noisy maximum multiplicity of the join key
+
+    // Equal-width histogram bins behind the index: bin i holds [domain_min + i*bin_width, domain_min + (i+1)*bin_width)
+    int64_t domain_min;
+    int64_t bin_width;
+
+    Synopsis(int count, const std::vector<std::pair<int, int>>& idx = {}, int mf = 1);
+
+    // Synopsis of a relation sorted on the indexed attribute, with the bin layout of its histogram
+    Synopsis(const std::vector<std::pair<int, int>>& idx, int64_t min_value, int64_t width);
+
+    // Public output size of a DP resize over an input of input_size rows
+    int resize_bound(int input_size) const;
+
+    // Inclusive row range covering every row whose indexed value may lie in [lower, upper];
+    // first > second when no bin overlaps the value range
+    std::pair<int, int> covering_range(int64_t lower, int64_t upper) const;
+};
+
+// Implementations
+
+Synopsis::Synopsis(int count, const std::vector<std::pair<int, int>>& idx, int mf)
+    : noisy_count(count), index(idx), max_frequency(mf), domain_min(0), bin_width(1) {}
+
+Synopsis::Synopsis(const std::vector<std::pair<int, int>>& idx, int64_t min_value, int64_t width)
+    : noisy_count(idx.empty() ? 0 : idx.back().second + 1), index(idx), max_frequency(1),
+      domain_min(min_value), bin_width(width) {}
+
+int Synopsis::resize_bound(int input_size) const {
+    return std::max(0, std::min(noisy_count, input_size));
+}
+
+std::pair<int, int> Synopsis::covering_range(int64_t lower, int64_t upper) const {
+    int bins = index.size();
+    int64_t domain_max = domain_min + bins * bin_width - 1;
+    if (bins == 0 || lower > upper || upper < domain_min || lower > domain_max) {
+        return std::make_pair(0, -1);
+    }
+
+    int first_bin = static_cast<int>((std::max(lower, domain_min) - domain_min) / bin_width);
+    int last_bin = static_cast<int>((std::min(upper, domain_max) - domain_min) / bin_width);
+
+    // Noisy ranges need not grow monotonically with the bin, so take the hull of every
+    // non-empty range in between; empty ranges (first > second) cover no row
+    int first = std::numeric_limits<int>::max();
+    int last = -1;
+    for (int bin = first_bin; bin <= last_bin; bin++) {
+        if (index[bin].first > index[bin].second) continue;
+        first = std::min(first, index[bin].first);
+        last = std::max(last, index[bin].second);
+    }
+    return last < 0 ? std::make_pair(0, -1) : std::make_pair(first, last);
+}
+
+#endif // SYNOPSIS_HPP
@@ -83,7 +83,7 @@ int main(int argc, char** argv) {
     //SecureRelation index_join_result = index_join_op.execute(relationA, relationC);
 
     //Step 3. Reconstruct indexes and join (A-C) with B
-    auto newIndex = index_join_op.rebuild_index();
+    auto newIndex = index_join_op.output_index;
 #ifdef DEBUG_LOG
     // Printing out the rebuilt index
         for (const auto& indexPair : newIndex) {
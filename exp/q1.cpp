@@ -3,6 +3,8 @@
 #include "core/op_idx_equijoin.hpp"
 #include "core/op_agg_count.hpp"
 #include "core/op_filter.hpp"
+#include "core/op_idx_filter.hpp"
+#include <algorithm>
 #include "core/relation.hpp"
 
 // Utility function to initialize a relation with random values and flag bits
@@ -22,6 +24,23 @@ void init_relation(SecureRelation& relation, int num_cols, int num_rows, bool mi
     }
 }
 
+// Simulated noisy CDF index of a column sorted ascending: the row range of every bin of
+// bin_width values from 0, widened by noise rows on each side; empty bins get (start, start - 1)
+Synopsis simulate_index(const std::vector<int>& sorted_values, int bin_width, int bins, int noise) {
+    std::vector<std::pair<int, int>> index;
+    int rows = sorted_values.size();
+    for (int bin = 0; bin < bins; ++bin) {
+        int lo = std::lower_bound(sorted_values.begin(), sorted_values.end(), bin * bin_width) - sorted_values.begin();
+        int hi = std::lower_bound(sorted_values.begin(), sorted_values.end(), (bin + 1) * bin_width) - sorted_values.begin() - 1;
+        if (lo > hi) {
+            index.push_back({lo, lo - 1});
+        } else {
+            index.push_back({std::max(lo - noise, 0), std::min(hi + noise, rows - 1)});
+        }
+    }
+    return Synopsis(index, 0, bin_width);
+}
+
 // Utility function to get the memory size of a SecureRelation object in bytes
 size_t getRelationMemorySize(const SecureRelation& relation) {
     size_t memorySize = 0;
@@ -46,13 +65,23 @@ int main(int argc, char** argv) {
     setup_semi_honest(io, party);
 
 
-    // Q3 - Baseline 1
-    // Sim SargAcc of Loan data [sized 7308]
-    SecureRelation relationA(1, 83);
-    init_relation(relationA, 1, 83);
+    // Q1
+    // Sim Loan data [sized 7308] sorted on duration, 71 loans with duration = 36
+    const int loan_rows = 7308, matches = 71;
+    std::vector<int> durations(loan_rows);
+    for (int row = 0; row < loan_rows; ++row) {
+        int middle = (loan_rows - matches) / 2;
+        durations[row] = row < middle ? 24 : (row < middle + matches ? 36 : 48);
+    }
+    SecureRelation relationA(1, loan_rows);
+    for (int row = 0; row < loan_rows; ++row) {
+        relationA.columns[0][row] = Integer(32, durations[row], ALICE);
+        relationA.flags[row] = Integer(1, 1, ALICE);
+    }
+    Synopsis loan_synopsis = simulate_index(durations, 12, 6, 6);
 
-    // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    // Setup filter: duration = 36 scans only the noisy index range of its bin [sized 83]
+    IndexFilterOperator filter_by_fixed_value(0, 36, 36, loan_synopsis);
 
     // Setup count operator
     CountOperator count_op;
@@ -76,7 +105,7 @@ int main(int argc, char** argv) {
     std::cout << "Results:\n";
     std::cout << "---------\n";
     std::cout << "Memory size of the index join result relation: " 
-              << getRelationMemorySize(relationA) + getRelationMemorySize(filtered_relationA) + getRelationMemorySize(result)
+              << getRelationMemorySize(filtered_relationA) + getRelationMemorySize(result)
               << " bytes\n";
     std::cout << "Index EquiJoin execution time: " 
               << duration 
@@ -2,7 +2,7 @@
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
 #include "core/op_agg_count.hpp"
-#include "core/op_filter.hpp"
+#include "core/op_dp_filter.hpp"
 #include "core/relation.hpp"
 
 // Utility function to initialize a relation with random values and flag bits
@@ -51,8 +51,9 @@ int main(int argc, char** argv) {
     SecureRelation relationA(1, 7308);
     init_relation(relationA, 1, 7308);
 
-    // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    // Setup filter with DP resize to the noisy bound of the synopsis
+    Synopsis loan_synopsis(71);
+    DPFilterOperator filter_by_fixed_value(Predicate::compare(0, CompareOp::EQ, 1), loan_synopsis);
 
     // Setup count operator
     CountOperator count_op;
@@ -63,10 +64,8 @@ int main(int argc, char** argv) {
     
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    //Step 1. Filter Loan table
+    //Step 1. Filter Loan table and compact to the DP upper bound in one pass
     SecureRelation filtered_relationA = filter_by_fixed_value.execute(relationA);
-    // compact size to DP upper bounds
-    filtered_relationA.compact(71);
 
     //Step 2. Count
     SecureRelation result = count_op.execute(filtered_relationA);
@@ -3,6 +3,8 @@
 #include "core/op_idx_equijoin.hpp"
 #include "core/op_agg_count.hpp"
 #include "core/op_filter.hpp"
+#include "core/op_idx_filter.hpp"
+#include <algorithm>
 #include "core/relation.hpp"
 
 // Utility function to initialize a relation with random values and flag bits
@@ -22,6 +24,23 @@ void init_relation(SecureRelation& relation, int num_cols, int num_rows, bool mi
     }
 }
 
+// Simulated noisy CDF index of a column sorted ascending: the row range of every bin of
+// bin_width values from 0, widened by noise rows on each side; empty bins get (start, start - 1)
+Synopsis simulate_index(const std::vector<int>& sorted_values, int bin_width, int bins, int noise) {
+    std::vector<std::pair<int, int>> index;
+    int rows = sorted_values.size();
+    for (int bin = 0; bin < bins; ++bin) {
+        int lo = std::lower_bound(sorted_values.begin(), sorted_values.end(), bin * bin_width) - sorted_values.begin();
+        int hi = std::lower_bound(sorted_values.begin(), sorted_values.end(), (bin + 1) * bin_width) - sorted_values.begin() - 1;
+        if (lo > hi) {
+            index.push_back({lo, lo - 1});
+        } else {
+            index.push_back({std::max(lo - noise, 0), std::min(hi + noise, rows - 1)});
+        }
+    }
+    return Synopsis(index, 0, bin_width);
+}
+
 // Utility function to get the memory size of a SecureRelation object in bytes
 size_t getRelationMemorySize(const SecureRelation& relation) {
     size_t memorySize = 0;
@@ -47,12 +66,25 @@ int main(int argc, char** argv) {
 
 
     // Q2 
-    // Sim SargAcc of Loan data [sized 0-43 out of 42338]
-    SecureRelation relationA(1, 43);
-    init_relation(relationA, 1, 43);
+    // Sim Loan data [sized 42338] sorted on amount, 37 loans with 10000 <= amount < 20000
+    const int loan_rows = 42338, in_range = 37;
+    std::vector<int> amounts(loan_rows);
+    for (int row = 0; row < loan_rows; ++row) {
+        int middle = (loan_rows - in_range) / 2;
+        amounts[row] = row < middle ? rand() % 10000 : (row < middle + in_range ? 10000 + rand() % 10000 : 20000 + rand() % 80000);
+    }
+    std::sort(amounts.begin(), amounts.end());
+    SecureRelation relationA(2, loan_rows);
+    for (int row = 0; row < loan_rows; ++row) {
+        relationA.columns[0][row] = Integer(32, amounts[row], ALICE);
+        relationA.columns[1][row] = Integer(32, rand() % 4, ALICE);
+        relationA.flags[row] = Integer(1, 1, ALICE);
+    }
+    Synopsis loan_synopsis = simulate_index(amounts, 10000, 10, 3);
 
-    // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    // Setup filter: amount > 10000 AND amount < 20000 scans only the noisy index range of its bin
+    // [sized 43]; k_symbol = 'LEASING' is the residual predicate (column 0 amount, column 1 k_symbol code)
+    IndexFilterOperator filter_by_fixed_value(0, 10001, 19999, loan_synopsis, Predicate::compare(1, CompareOp::EQ, 1));
 
     // Setup count operator
     CountOperator count_op;
@@ -73,7 +105,7 @@ int main(int argc, char** argv) {
     std::cout << "Results:\n";
     std::cout << "---------\n";
     std::cout << "Memory size: " 
-              << getRelationMemorySize(relationA) + getRelationMemorySize(filtered_relationA) + getRelationMemorySize(result)
+              << getRelationMemorySize(filtered_relationA) + getRelationMemorySize(result)
               << " bytes\n";
     std::cout << "Index EquiJoin execution time: " 
               << duration 
@@ -48,11 +48,14 @@ int main(int argc, char** argv) {
 
     // Q3 - Baseline 1
     // Sim SeqAcc of Loan data [sized 46338]
-    SecureRelation relationA(1, 46338);
-    init_relation(relationA, 1, 46338);
-
-    // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    SecureRelation relationA(2, 46338);
+    init_relation(relationA, 2, 46338);
+
+    // Setup filter: amount > 10000 AND amount < 20000 AND k_symbol = 'LEASING' (column 0 amount, column 1 k_symbol code)
+    Predicate q2_predicate = Predicate::compare(0, CompareOp::GT, 10000)
+                             && Predicate::compare(0, CompareOp::LT, 20000)
+                             && Predicate::compare(1, CompareOp::EQ, 1);
+    FilterOperator filter_by_fixed_value(q2_predicate);
 
     // Setup count operator
     CountOperator count_op;
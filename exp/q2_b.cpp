@@ -2,7 +2,7 @@
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
 #include "core/op_agg_count.hpp"
-#include "core/op_filter.hpp"
+#include "core/op_dp_filter.hpp"
 #include "core/relation.hpp"
 
 // Utility function to initialize a relation with random values and flag bits
@@ -48,11 +48,15 @@ int main(int argc, char** argv) {
 
     // Q3 - Baseline 1
     // Sim SeqAcc of Loan data [sized 42338]
-    SecureRelation relationA(1, 42338);
-    init_relation(relationA, 1, 42338);
+    SecureRelation relationA(2, 42338);
+    init_relation(relationA, 2, 42338);
 
-    // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    // Setup filter: amount > 10000 AND amount < 20000 AND k_symbol = 'LEASING' (column 0 amount, column 1 k_symbol code)
+    Predicate q2_predicate = Predicate::compare(0, CompareOp::GT, 10000)
+                             && Predicate::compare(0, CompareOp::LT, 20000)
+                             && Predicate::compare(1, CompareOp::EQ, 1);
+    Synopsis order_synopsis(21);
+    DPFilterOperator filter_by_fixed_value(q2_predicate, order_synopsis);
 
     // Setup count operator
     CountOperator count_op;
@@ -63,10 +67,8 @@ int main(int argc, char** argv) {
     
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    //Step 1. Filter Loan table
+    //Step 1. Filter Loan table and compact to the DP upper bound in one pass
     SecureRelation filtered_relationA = filter_by_fixed_value.execute(relationA);
-    // compact size to DP upper bounds
-    filtered_relationA.compact(21);
 
     //Step 2. Count
     SecureRelation result = count_op.execute(filtered_relationA);
@@ -45,8 +45,11 @@ int main(int argc, char** argv) {
     NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
     setup_semi_honest(io, party);
 
-    // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    // Setup filter: amount > 10000 AND amount < 20000 AND k_symbol = 'LEASING' (column 0 amount, column 1 k_symbol code)
+    Predicate q2_predicate = Predicate::compare(0, CompareOp::GT, 10000)
+                             && Predicate::compare(0, CompareOp::LT, 20000)
+                             && Predicate::compare(1, CompareOp::EQ, 1);
+    FilterOperator filter_by_fixed_value(q2_predicate);
 
     // Setup count operator
     CountOperator count_op;
@@ -57,8 +60,8 @@ int main(int argc, char** argv) {
 
     for (size_t i = 0; i < input_sizes.size(); ++i) {
         // Initialize relation with random values
-        SecureRelation relationA(1, input_sizes[i]);
-        init_relation(relationA, 1, input_sizes[i]);
+        SecureRelation relationA(2, input_sizes[i]);
+        init_relation(relationA, 2, input_sizes[i]);
 
         auto start_time = std::chrono::high_resolution_clock::now();
 
@@ -1,7 +1,9 @@
 // exp - query 3
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
+#include "core/op_semijoin.hpp"
 #include "core/op_agg_count.hpp"
+#include "core/op_distinct.hpp"
 #include "core/relation.hpp"
 
 // Utility function to initialize a relation with random values and flag bits
@@ -59,24 +61,28 @@ int main(int argc, char** argv) {
 
     CountOperator count_op;
 
+    // Distinct client IDs; there are at most as many as Client rows
+    DistinctOperator distinct_op(0, Synopsis(112));
+
     // DP indexes
     std::vector<std::pair<int, int>> indexA = { {0, 292}, {213, 581}, {502, 800}, {721, 834}, {755, 854}, {775, 869}, {808, 869}, {846, 869} };
     std::vector<std::pair<int, int>> indexB = { {0, 16}, {7, 44}, {21, 73}, {35, 81}, {35, 90}, {35, 96}, {35, 104}, {35, 111} };
 
-    // Index (non-expanding) join of Disp and Client on client ID
-    IndexEquiJoinOperator index_join_op(indexA, indexB, 0, 0, IndexEquiJoinOperator::SMALLER_REL); 
+    // Index semi-join of Disp with Client on client ID: Disp rows with a matching client
+    SemiJoinOperator index_join_op(indexA, indexB, 0, 0);
 
 
     //Step 1. Bypass filters
 
     auto start_time = std::chrono::high_resolution_clock::now();
-    //Step 2. Index join
+    //Step 2. Index semi-join
     SecureRelation index_join_result = index_join_op.execute(relationA, relationB);
     size_t mem_join = getRelationMemorySize(index_join_result);
 
-    //Step 3. Count distinct (already sorted)
-    SecureRelation result = count_op.execute(index_join_result);
-    size_t mem_cnt = getRelationMemorySize(index_join_result);
+    //Step 3. Count distinct
+    SecureRelation distinct_result = distinct_op.execute(index_join_result);
+    SecureRelation result = count_op.execute(distinct_result);
+    size_t mem_cnt = getRelationMemorySize(distinct_result);
 
 
     auto end_time = std::chrono::high_resolution_clock::now();
@@ -88,7 +94,7 @@ int main(int argc, char** argv) {
     std::cout << "Memory size: " 
               << mem_filter + mem_join + mem_cnt
               << " bytes\n";
-    std::cout << "Index EquiJoin execution time: " 
+    std::cout << "Index SemiJoin execution time: " 
               << duration_index_join 
               << " milliseconds\n\n";
 
@@ -56,7 +56,7 @@ int main(int argc, char** argv) {
     init_relation(relationB, 1, 5369);
 
     // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    FilterOperator filter_by_fixed_value(0, 1, "eq");
 
     // Setup count operator
     CountOperator count_op;
@@ -2,7 +2,8 @@
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
 #include "core/op_agg_count.hpp"
-#include "core/op_filter.hpp"
+#include "core/op_distinct.hpp"
+#include "core/op_dp_filter.hpp"
 #include "core/relation.hpp"
 
 // Utility function to initialize a relation with random values and flag bits
@@ -55,8 +56,11 @@ int main(int argc, char** argv) {
     SecureRelation relationB(1, 5369);
     init_relation(relationB, 1, 5369);
 
-    // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    // Setup filters with DP resize to the noisy bounds of the synopses
+    Synopsis disp_synopsis(811);
+    Synopsis client_synopsis(95);
+    DPFilterOperator filter_disp(Predicate::compare(0, CompareOp::EQ, 1), disp_synopsis);
+    DPFilterOperator filter_client(Predicate::compare(0, CompareOp::EQ, 1), client_synopsis);
 
     // Setup count operator
     CountOperator count_op;
@@ -68,11 +72,9 @@ int main(int argc, char** argv) {
     auto start_time = std::chrono::high_resolution_clock::now();
 
     //Step 1. Filter Disp table - resize to size of 841 (DP resized)
-    SecureRelation filtered_relationA = filter_by_fixed_value.execute(relationA);
-    SecureRelation filtered_relationB = filter_by_fixed_value.execute(relationB);
+    SecureRelation filtered_relationA = filter_disp.execute(relationA);
+    SecureRelation filtered_relationB = filter_client.execute(relationB);
     size_t mem_filter = getRelationMemorySize(relationA) + getRelationMemorySize(relationB);
-    filtered_relationA.compact(811);
-    filtered_relationB.compact(95);
     
     //Step 2. Nested loop join 
     SecureRelation equi_join_result = equijoin_op.execute(filtered_relationA, filtered_relationB);
@@ -80,8 +82,9 @@ int main(int argc, char** argv) {
     equi_join_result.compact(12);
    
 
-    //Step 3. Count distinct (already sorted, directly count)
-    SecureRelation result = count_op.execute(equi_join_result);
+    //Step 3. Count distinct
+    SecureRelation distinct_result = DistinctOperator(0).execute(equi_join_result);
+    SecureRelation result = count_op.execute(distinct_result);
     size_t mem_cnt = getRelationMemorySize(equi_join_result);
 
 
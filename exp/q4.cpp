@@ -2,6 +2,8 @@
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
 #include "core/op_agg_count.hpp"
+#include "core/op_group_by.hpp"
+#include "core/op_order_by.hpp"
 #include "core/relation.hpp"
 
 // Utility function to initialize a relation with random values and flag bits
@@ -54,7 +56,12 @@ int main(int argc, char** argv) {
     SecureRelation relationB(1, 8096);
     init_relation(relationB, 1, 8096);
 
-    CountOperator count_op;
+    // Group by a.date with count; at most one date per account, noised like the other synopses
+    Synopsis group_synopsis(106);
+    GroupByOperator group_by_op(0, CountOperator(), group_synopsis);
+
+    // Order by count(a.date); the limit covers every group, so this is a plain sort of the groups
+    OrderByLimitOperator order_by_op(1, 106);
 
     // DP indexes
     std::vector<std::pair<int, int>> indexA = { {0, 18}, {6, 41}, {16, 65}, {25, 72}, {25, 79}, {25, 89}, {25, 97}, {25, 105}};
@@ -75,9 +82,11 @@ int main(int argc, char** argv) {
     SecureRelation index_join_result = index_join_op.execute(relationA, relationB);
     size_t mem_join = getRelationMemorySize(index_join_result);
 
-    //Step 3. Simulate groupby perf using sorting + count
-    index_join_result.sort_by_column(0);
-    SecureRelation result = count_op.execute(index_join_result);
+    //Step 3. Group by with count
+    SecureRelation group_result = group_by_op.execute(index_join_result);
+
+    //Step 4. Order by count
+    SecureRelation result = order_by_op.execute(group_result);
 
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration_index_join = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
@@ -2,6 +2,8 @@
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
 #include "core/op_agg_count.hpp"
+#include "core/op_group_by.hpp"
+#include "core/op_order_by.hpp"
 #include "core/op_filter.hpp"
 #include "core/relation.hpp"
 
@@ -56,10 +58,14 @@ int main(int argc, char** argv) {
     init_relation(relationB, 1, 1056322);
 
     // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    FilterOperator filter_by_fixed_value(0, 1, "eq");
 
-    // Setup count operator
-    CountOperator count_op;
+    // Group by a.date with count, same noisy group count as the Q4 plan
+    Synopsis group_synopsis(106);
+    GroupByOperator group_by_op(0, CountOperator(), group_synopsis);
+
+    // Order by count(a.date); the limit covers every group, so this is a plain sort of the groups
+    OrderByLimitOperator order_by_op(1, 106);
 
     // Naive nested loop join (EquiJoin)
     EquiJoinOperator equijoin_op(0, 0);
@@ -83,8 +89,11 @@ int main(int argc, char** argv) {
     size_t mem_join = getRelationMemorySize(equi_join_result);
     equi_join_result.compact(127);
 
-    //Step 3. Count distinct (sort + count, already sorted)
-    SecureRelation result = count_op.execute(equi_join_result);    
+    //Step 3. Group by with count
+    SecureRelation group_result = group_by_op.execute(equi_join_result);
+
+    //Step 4. Order by count
+    SecureRelation result = order_by_op.execute(group_result);
 
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration_index_join = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
@@ -1,7 +1,9 @@
 // exp - query 3
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
+#include "core/op_semijoin.hpp"
 #include "core/op_agg_count.hpp"
+#include "core/op_distinct.hpp"
 #include "core/relation.hpp"
 
 // Utility function to initialize a relation with random values and flag bits
@@ -63,38 +65,31 @@ int main(int argc, char** argv) {
     std::vector<std::pair<int, int>> indexB = { {0, 2644}, {2630, 5080}, {5055, 7058}, {7022, 7404}, {7354, 7543}, {7481, 7746}, {7671, 7900}, {7808, 8095} };
     std::vector<std::pair<int, int>> indexC = { {0, 101}, {87, 208}, {179, 302}, {262, 341}, {286, 355}, {289, 369}, {290, 382}, {291, 393} };
 
-    // Setup count operator
+    // Setup count distinct operators; there are at most as many accounts as Account rows
+    DistinctOperator distinct_op(0, Synopsis(106));
     CountOperator count_op;
 
     //Step 1. Bypass filters
 
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    //Step 2. Index join A-C
+    //Step 2. Index semi-join A-C
     relationA.sort_by_column(0);
     relationC.sort_by_column(0);
 
-    // Index (non-expanding) join of Account and Order on account_id
-    // Join order (A-C)-B
-    IndexEquiJoinOperator index_join_op(indexA, indexC, 0, 0, IndexEquiJoinOperator::SMALLER_REL); 
+    // Only count(distinct account_id) is needed, so Account is semi-joined with Order
+    // and Trans instead of being expanded: the result keeps one row per account
+    SemiJoinOperator index_join_op(indexA, indexC, 0, 0);
     SecureRelation index_join_result = index_join_op.execute(relationA, relationC);
 
-    //Step 3. Reconstruct indexes and join (A-C) with B
-    auto newIndex = index_join_op.rebuild_index();
-#ifdef DEBUG_LOG
-    // Printing out the rebuilt index
-        for (const auto& indexPair : newIndex) {
-        std::cout << "Start Index: " << indexPair.first << ", End Index: " << indexPair.second << std::endl;
-    }
-#endif
+    //Step 3. Index semi-join (A-C) with B; the semi-join keeps the layout and index of A
     relationB.sort_by_column(0);
-    IndexEquiJoinOperator index_join_op_2(newIndex, indexB, 0, 0, IndexEquiJoinOperator::LARGER_REL); 
+    SemiJoinOperator index_join_op_2(indexA, indexB, 0, 0);
     SecureRelation index_join_result_2 = index_join_op_2.execute(index_join_result, relationB);
-    
 
-    //Step 4. Distinct (provactive distinct - no secure computing costs)
-    index_join_result_2.sort_by_column(0);
-    SecureRelation result = count_op.execute(index_join_result_2);
+    //Step 4. Count distinct; A is still sorted on account_id, so the distinct needs no sort
+    SecureRelation distinct_result = distinct_op.execute(index_join_result_2);
+    SecureRelation result = count_op.execute(distinct_result);
 
 
     auto end_time = std::chrono::high_resolution_clock::now();
@@ -109,7 +104,7 @@ int main(int argc, char** argv) {
                  getRelationMemorySize(relationA) + \
                  getRelationMemorySize(relationB) + getRelationMemorySize(relationC)
               << " bytes\n";
-    std::cout << "Index EquiJoin execution time: " 
+    std::cout << "Index SemiJoin execution time: " 
               << duration_index_join 
               << " milliseconds\n\n";
 
@@ -60,7 +60,7 @@ int main(int argc, char** argv) {
     init_relation(relationC, 1, 64);
 
     // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    FilterOperator filter_by_fixed_value(0, 1, "eq");
 
     // Setup count operator
     CountOperator count_op;
@@ -2,6 +2,7 @@
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
 #include "core/op_agg_count.hpp"
+#include "core/op_distinct.hpp"
 #include "core/op_filter.hpp"
 #include "core/op_project.hpp"
 #include "core/relation.hpp"
@@ -61,7 +62,7 @@ int main(int argc, char** argv) {
     init_relation(relationC, 1, 6472);
 
     // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    FilterOperator filter_by_fixed_value(0, 1, "eq");
 
     // Setup count operator
     CountOperator count_op;
@@ -101,8 +102,9 @@ int main(int argc, char** argv) {
     equi_join_result_2.compact(9);
 
     
-    //Step 3. Count distinct 
-    SecureRelation result = count_op.execute(equi_join_result_2);
+    //Step 3. Count distinct
+    SecureRelation distinct_result = DistinctOperator(0).execute(equi_join_result_2);
+    SecureRelation result = count_op.execute(distinct_result);
     size_t mem_cnt = getRelationMemorySize(equi_join_result_2);
     
 
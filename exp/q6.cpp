@@ -1,7 +1,8 @@
 // exp - query 6
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
-#include "core/op_agg_count.hpp"
+#include "core/op_star_join.hpp"
+#include "core/op_aggregate.hpp"
 #include "core/relation.hpp"
 
 // Utility function to initialize a relation with random values and flag bits
@@ -46,9 +47,9 @@ int main(int argc, char** argv) {
 
 
     // Q6 - Caplan
-    // Sim IdxAcc of Order with c.k_symbol = 'LEASING' [sized 394]
-    SecureRelation relationA(1, 394);
-    init_relation(relationA, 1, 394);
+    // Sim IdxAcc of Order with c.k_symbol = 'LEASING' [sized 394], columns (account_id, amount)
+    SecureRelation relationA(2, 394);
+    init_relation(relationA, 2, 394);
     
     // Sim IdxAcc of Trans data with operation='VYBER KARTOU' [sized 8036]
     SecureRelation relationB(1, 8096);
@@ -66,40 +67,22 @@ int main(int argc, char** argv) {
     size_t mf_trans = 75;
     size_t mf_disp = 3;
 
-    // Setup count operator
-    CountOperator count_op;
+    // Setup sum operator over the amount of the order, column 1 of the join result
+    SumOperator sum_op(1);
 
     //Step 1. Bypass two filters 
 
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    //Step 2. Index join A-C
+    //Step 2. Star join A-C-B on account_id, bucket by bucket
     relationA.sort_by_column(0);
     relationC.sort_by_column(0);
-
-    // Index (non-expanding) join of Account and Order on account_id
-    // Join order (A-C)-B
-    IndexEquiJoinOperator index_join_op(indexA, indexC, 0, 0, IndexEquiJoinOperator::MF, 0, mf_order, mf_disp); 
-    SecureRelation index_join_result = index_join_op.execute(relationA, relationC);
-
-    //IndexEquiJoinOperator index_join_op(indexA, indexC, 0, 0, IndexEquiJoinOperator::LARGER_REL); 
-    //SecureRelation index_join_result = index_join_op.execute(relationA, relationC);
-
-    //Step 3. Reconstruct indexes and join (A-C) with B
-    auto newIndex = index_join_op.rebuild_index();
-#ifdef DEBUG_LOG
-    // Printing out the rebuilt index
-        for (const auto& indexPair : newIndex) {
-        std::cout << "Start Index: " << indexPair.first << ", End Index: " << indexPair.second << std::endl;
-    }
-#endif
     relationB.sort_by_column(0);
-    IndexEquiJoinOperator index_join_op_2(newIndex, indexB, 0, 0, IndexEquiJoinOperator::MF, 0, mf_order*mf_disp, mf_trans); 
-    SecureRelation index_join_result_2 = index_join_op_2.execute(index_join_result, relationB);
-    
+    StarJoinOperator star_join_op({indexA, indexC, indexB}, {0, 0, 0}, {static_cast<int>(mf_order), static_cast<int>(mf_disp), static_cast<int>(mf_trans)});
+    SecureRelation star_join_result = star_join_op.execute({relationA, relationC, relationB});
 
-    //Step 4. Sum (simulate sum using count, same imp)
-    SecureRelation result = count_op.execute(index_join_result_2);
+    //Step 3. Sum
+    SecureRelation result = sum_op.execute(star_join_result);
 
 
     auto end_time = std::chrono::high_resolution_clock::now();
@@ -109,12 +92,12 @@ int main(int argc, char** argv) {
     std::cout << "Results:\n";
     std::cout << "---------\n";
     std::cout << "Memory size (query plan): " 
-              << getRelationMemorySize(index_join_result) + \
-                 getRelationMemorySize(index_join_result_2) + \
+              << getRelationMemorySize(star_join_result) + \
                  getRelationMemorySize(relationA) + \
-                 getRelationMemorySize(relationB) + getRelationMemorySize(relationC)
+                 getRelationMemorySize(relationB) + \
+                 getRelationMemorySize(relationC)
               << " bytes\n";
-    std::cout << "Index EquiJoin execution time: " 
+    std::cout << "Star Join execution time: " 
               << duration_index_join 
               << " milliseconds\n\n";
 
@@ -1,7 +1,7 @@
 // exp - query 3
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
-#include "core/op_agg_count.hpp"
+#include "core/op_aggregate.hpp"
 #include "core/op_filter.hpp"
 #include "core/op_project.hpp"
 #include "core/relation.hpp"
@@ -61,10 +61,10 @@ int main(int argc, char** argv) {
     init_relation(relationC, 1, 5426);
 
     // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    FilterOperator filter_by_fixed_value(0, 1, "eq");
 
-    // Setup count operator
-    CountOperator count_op;
+    // Setup sum operator; the relations only carry the key, and the cost does not depend on the column
+    SumOperator sum_op(0);
 
     // Naive nested loop join (EquiJoin)
     EquiJoinOperator equijoin_op(0, 0);
@@ -106,8 +106,8 @@ int main(int argc, char** argv) {
     SecureRelation equi_join_result_2 = equijoin_op.execute(equi_join_result, filtered_relationA);
     size_t mem_join_2 = getRelationMemorySize(equi_join_result_2);
 
-    //Step 3. Count 
-    SecureRelation result = count_op.execute(equi_join_result_2);
+    //Step 3. Sum
+    SecureRelation result = sum_op.execute(equi_join_result_2);
      size_t mem_cnt = getRelationMemorySize(equi_join_result_2);
 
 
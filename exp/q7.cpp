@@ -1,7 +1,8 @@
 // exp - query 3
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
-#include "core/op_agg_count.hpp"
+#include "core/op_star_join.hpp"
+#include "core/op_aggregate.hpp"
 #include "core/relation.hpp"
 
 // Utility function to initialize a relation with random values and flag bits
@@ -58,9 +59,9 @@ int main(int argc, char** argv) {
     SecureRelation relationC(1, 5426);
     init_relation(relationC, 1, 5426);
 
-    // Sim SargAcc of Order with c.k_symbol = 'LEASING' [sized 394]
-    SecureRelation relationD(1, 394);
-    init_relation(relationD, 1, 394);
+    // Sim SargAcc of Order with c.k_symbol = 'LEASING' [sized 394], columns (account_id, amount)
+    SecureRelation relationD(2, 394);
+    init_relation(relationD, 2, 394);
 
     // DP indexes
     std::vector<std::pair<int, int>> indexA = { {0, 18}, {6, 41}, {16, 65}, {25, 72}, {25, 79}, {25, 89}, {25, 97}, {25, 105}};
@@ -71,41 +72,23 @@ int main(int argc, char** argv) {
     size_t mf_disp = 3;
     size_t mf_trans = 75;
 
-    // Setup count operator
-    CountOperator count_op;
+    // Setup min operator over the amount of the order, column 2 of the join result
+    MinOperator min_op(2);
 
     //Step 1. Bypass filters 
     
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    //Step 2. Index join A-D
+    //Step 2. Star join A-D-C-B on account_id, bucket by bucket
     relationA.sort_by_column(0);
     relationD.sort_by_column(0);
-    IndexEquiJoinOperator index_join_op(indexA, indexD, 0, 0, IndexEquiJoinOperator::MF, 0, 1, mf_order); 
-    SecureRelation index_join_result = index_join_op.execute(relationA, relationD);
-
-    //Step 3. Reconstruct indexes and join (A-D) with C
-    auto newIndex = index_join_op.rebuild_index();
-#ifdef DEBUG_LOG
-    // Printing out the rebuilt index
-        for (const auto& indexPair : newIndex) {
-        std::cout << "Start Index: " << indexPair.first << ", End Index: " << indexPair.second << std::endl;
-    }
-#endif
     relationC.sort_by_column(0);
-    // many to many join order (MFs 2:3)
-    IndexEquiJoinOperator index_join_op_2(newIndex, indexC, 0, 0, IndexEquiJoinOperator::MF, 0, mf_order, mf_disp); 
-    SecureRelation index_join_result_2 = index_join_op_2.execute(index_join_result, relationC);
-    
-    //Step 4. Reconstruct indexes and join ((A-D)-C) with B
-    auto newIndex2 = index_join_op_2.rebuild_index();
     relationB.sort_by_column(0);
-    // many to many join order (MFs 6:75)
-    IndexEquiJoinOperator index_join_op_3(newIndex2, indexB, 0, 0, IndexEquiJoinOperator::MF, 0, mf_order*mf_disp, mf_trans); 
-    SecureRelation index_join_result_3 = index_join_op_3.execute(index_join_result_2, relationB);
+    StarJoinOperator star_join_op({indexA, indexD, indexC, indexB}, {0, 0, 0, 0}, {1, static_cast<int>(mf_order), static_cast<int>(mf_disp), static_cast<int>(mf_trans)});
+    SecureRelation star_join_result = star_join_op.execute({relationA, relationD, relationC, relationB});
 
-    //Step 5. Min (simulate min using count, same imp)
-    SecureRelation result = count_op.execute(index_join_result_3);
+    //Step 3. Min
+    SecureRelation result = min_op.execute(star_join_result);
 
 
     auto end_time = std::chrono::high_resolution_clock::now();
@@ -115,15 +98,13 @@ int main(int argc, char** argv) {
     std::cout << "Results:\n";
     std::cout << "---------\n";
     std::cout << "Memory size (query plan): " 
-              << getRelationMemorySize(index_join_result) + \
-                 getRelationMemorySize(index_join_result_2) + \
-                 getRelationMemorySize(index_join_result_3) + \
+              << getRelationMemorySize(star_join_result) + \
                  getRelationMemorySize(relationA) + \
                  getRelationMemorySize(relationB) + \
                  getRelationMemorySize(relationC) + \
                  getRelationMemorySize(relationD)
               << " bytes\n";
-    std::cout << "Index EquiJoin execution time: " 
+    std::cout << "Star Join execution time: " 
               << duration_index_join 
               << " milliseconds\n\n";
 
@@ -1,7 +1,7 @@
 // exp - query 7
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
-#include "core/op_agg_count.hpp"
+#include "core/op_aggregate.hpp"
 #include "core/op_filter.hpp"
 #include "core/op_project.hpp"
 #include "core/relation.hpp"
@@ -66,10 +66,10 @@ int main(int argc, char** argv) {
 
 
     // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    FilterOperator filter_by_fixed_value(0, 1, "eq");
 
-    // Setup count operator
-    CountOperator count_op;
+    // Setup min operator; the relations only carry the key, and the cost does not depend on the column
+    MinOperator min_op(0);
 
     // Naive nested loop join (EquiJoin)
     EquiJoinOperator equijoin_op(0, 0);
@@ -129,8 +129,8 @@ int main(int argc, char** argv) {
     size_t mem_join_3 = getRelationMemorySize(equi_join_result_3);
     equi_join_result_3.compact(17);
 
-    //Step 3. Count 
-    SecureRelation result = count_op.execute(equi_join_result_3);
+    //Step 3. Min
+    SecureRelation result = min_op.execute(equi_join_result_3);
     size_t mem_cnt = getRelationMemorySize(equi_join_result_3);
 
     
@@ -1,7 +1,8 @@
 // exp - query 8
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
-#include "core/op_agg_count.hpp"
+#include "core/op_star_join.hpp"
+#include "core/op_aggregate.hpp"
 #include "core/relation.hpp"
 
 // Utility function to initialize a relation with random values and flag bits
@@ -58,9 +59,9 @@ int main(int argc, char** argv) {
     SecureRelation relationC(1, 5426);
     init_relation(relationC, 1, 5426);
 
-    // Sim SargAcc of Order with k_symbol = 'LEASING' [sized 394]
-    SecureRelation relationD(1, 394);
-    init_relation(relationD, 1, 394);
+    // Sim SargAcc of Order with k_symbol = 'LEASING' [sized 394], columns (account_id, amount)
+    SecureRelation relationD(2, 394);
+    init_relation(relationD, 2, 394);
 
     // Sim SargAcc of Loan with duration = 36 [sized 191]
     SecureRelation relationE(1, 191);
@@ -76,39 +77,24 @@ int main(int argc, char** argv) {
     size_t mf_disp = 3;
     size_t mf_trans = 72;
 
-    // Setup count operator
-    CountOperator count_op;
+    // Setup max operator over the amount of the order, column 3 of the join result
+    MaxOperator max_op(3);
 
     //Step 1. Bypass filters 
     
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    //Step 2. Index join A-E
+    //Step 2. Star join A-E-D-C-B on account_id, bucket by bucket
     relationA.sort_by_column(0);
     relationE.sort_by_column(0);
-    IndexEquiJoinOperator index_join_op(indexA, indexE, 0, 0, IndexEquiJoinOperator::SMALLER_REL); 
-    SecureRelation index_join_result = index_join_op.execute(relationA, relationE);
-
-    //Step 3. Reconstruct indexes and join (A-E) with D 
-    auto newIndex = index_join_op.rebuild_index();
     relationD.sort_by_column(0);
-    IndexEquiJoinOperator index_join_op_2(newIndex, indexD, 0, 0, IndexEquiJoinOperator::MF, 0, 1, mf_order); 
-    SecureRelation index_join_result_2 = index_join_op_2.execute(index_join_result, relationD);
-
-    //Step 4. Reconstruct indexes and join ((A-E)-D) with C 
-    auto newIndex_2 = index_join_op_2.rebuild_index();
     relationC.sort_by_column(0);
-    IndexEquiJoinOperator index_join_op_3(newIndex_2, indexC, 0, 0, IndexEquiJoinOperator::MF, 0, mf_order, mf_disp); 
-    SecureRelation index_join_result_3 = index_join_op_3.execute(index_join_result_2, relationC);
-    
-    //Step 5. Reconstruct indexes and join (((A-E)-D)-C) with B
-    auto newIndex2 = index_join_op_3.rebuild_index();
     relationB.sort_by_column(0);
-    IndexEquiJoinOperator index_join_op_4(newIndex2, indexB, 0, 0, IndexEquiJoinOperator::MF, 0, mf_order*mf_disp, mf_trans); 
-    SecureRelation index_join_result_4 = index_join_op_4.execute(index_join_result_3, relationB);
+    StarJoinOperator star_join_op({indexA, indexE, indexD, indexC, indexB}, {0, 0, 0, 0, 0}, {1, 1, static_cast<int>(mf_order), static_cast<int>(mf_disp), static_cast<int>(mf_trans)});
+    SecureRelation star_join_result = star_join_op.execute({relationA, relationE, relationD, relationC, relationB});
 
-    //Step 5. Max (simulate max using count, same imp)
-    SecureRelation result = count_op.execute(index_join_result_4);
+    //Step 3. Max
+    SecureRelation result = max_op.execute(star_join_result);
 
 
     auto end_time = std::chrono::high_resolution_clock::now();
@@ -118,17 +104,14 @@ int main(int argc, char** argv) {
     std::cout << "Results:\n";
     std::cout << "---------\n";
     std::cout << "Memory size (query plan): " 
-              << getRelationMemorySize(index_join_result) + \
-                 getRelationMemorySize(index_join_result_2) + \
-                 getRelationMemorySize(index_join_result_3) + \
-                 getRelationMemorySize(index_join_result_4) + \
+              << getRelationMemorySize(star_join_result) + \
                  getRelationMemorySize(relationA) + \
                  getRelationMemorySize(relationB) + \
                  getRelationMemorySize(relationC) + \
                  getRelationMemorySize(relationD) + \
                  getRelationMemorySize(relationE)
               << " bytes\n";
-    std::cout << "Index EquiJoin execution time: " 
+    std::cout << "Star Join execution time: " 
               << duration_index_join 
               << " milliseconds\n\n";
 
@@ -1,7 +1,7 @@
 // exp - query 8
 #include "core/op_equijoin.hpp"
 #include "core/op_idx_equijoin.hpp"
-#include "core/op_agg_count.hpp"
+#include "core/op_aggregate.hpp"
 #include "core/op_filter.hpp"
 #include "core/op_project.hpp"
 #include "core/relation.hpp"
@@ -70,10 +70,10 @@ int main(int argc, char** argv) {
 
 
     // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    FilterOperator filter_by_fixed_value(0, 1, "eq");
 
-    // Setup count operator
-    CountOperator count_op;
+    // Setup max operator; the relations only carry the key, and the cost does not depend on the column
+    MaxOperator max_op(0);
 
     // Naive nested loop join (EquiJoin)
     EquiJoinOperator equijoin_op(0, 0);
@@ -135,8 +135,8 @@ int main(int argc, char** argv) {
     size_t mem_join_4 = getRelationMemorySize(equi_join_result_4);
     equi_join_result_4.compact(9);
 
-    //Step 6. Count
-    SecureRelation result = count_op.execute(equi_join_result_4);
+    //Step 6. Max
+    SecureRelation result = max_op.execute(equi_join_result_4);
     size_t mem_cnt = getRelationMemorySize(equi_join_result_4);
 
     
@@ -54,17 +54,17 @@ void runQuery(int relationASize, int relationBSize, int relationCSize, int relat
     IndexEquiJoinOperator index_join_op(indexA, indexE, 0, 0, IndexEquiJoinOperator::SMALLER_REL);
     SecureRelation index_join_result = index_join_op.execute(relationA, relationE);
 
-    auto newIndex = index_join_op.rebuild_index();
+    auto newIndex = index_join_op.output_index;
     relationD.sort_by_column(0);
     IndexEquiJoinOperator index_join_op_2(newIndex, indexD, 0, 0, IndexEquiJoinOperator::MF, 0, 1, 2);
     SecureRelation index_join_result_2 = index_join_op_2.execute(index_join_result, relationD);
 
-    auto newIndex_2 = index_join_op_2.rebuild_index();
+    auto newIndex_2 = index_join_op_2.output_index;
     relationC.sort_by_column(0);
     IndexEquiJoinOperator index_join_op_3(newIndex_2, indexC, 0, 0, IndexEquiJoinOperator::MF, 0, mf_order, mf_disp);
     SecureRelation index_join_result_3 = index_join_op_3.execute(index_join_result_2, relationC);
 
-    auto newIndex2 = index_join_op_3.rebuild_index();
+    auto newIndex2 = index_join_op_3.output_index;
     relationB.sort_by_column(0);
     IndexEquiJoinOperator index_join_op_4(newIndex2, indexB, 0, 0, IndexEquiJoinOperator::MF, 0, mf_order * mf_disp, mf_trans);
     SecureRelation index_join_result_4 = index_join_op_4.execute(index_join_result_3, relationB);
@@ -50,7 +50,7 @@ int main(int argc, char** argv) {
     int rel_sz = 1 << 18;
     int sel_sz = 1 << 14;
     // Setup filter
-    FilterOperator filter_by_fixed_value(0, Integer(32, 1, ALICE), "eq");
+    FilterOperator filter_by_fixed_value(0, 1, "eq");
     // Naive nested loop join (EquiJoin)
     EquiJoinOperator equijoin_op(0, 0);
     
@@ -0,0 +1,84 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "core/relation.hpp"
+#include "core/op_aggregate.hpp"
+#include "core/op_multi_aggregate.hpp"
+#include <iostream>
+#include <chrono>
+#include <climits>
+#include <algorithm>
+
+using namespace emp;
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    // Relation (key, amount) with mixed flags
+    const int num_rows = 10000;
+    SecureRelation relation(2, num_rows);
+    long long sum = 0;
+    int count = 0, min = INT_MAX, max = INT_MIN;
+    for (int row = 0; row < num_rows; ++row) {
+        int amount = rand() % 20000 - 10000;
+        int flag = rand() % 2;
+        relation.columns[0][row] = Integer(32, row, ALICE);
+        relation.columns[1][row] = Integer(32, amount, ALICE);
+        relation.flags[row] = Integer(1, flag, ALICE);
+        if (flag) {
+            sum += amount;
+            count++;
+            min = std::min(min, amount);
+            max = std::max(max, amount);
+        }
+    }
+
+    struct Case {
+        const char* name;
+        AggregateOperator op;
+        long long expected;
+    };
+    Case cases[] = {
+        {"COUNT", AggregateOperator(AggregateOperator::COUNT), count},
+        {"SUM", SumOperator(1), sum},
+        {"MIN", MinOperator(1), min},
+        {"MAX", MaxOperator(1), max},
+        {"AVG", AvgOperator(1), count > 0 ? sum / count : 0},
+    };
+
+    int mismatches = 0;
+    for (auto& c : cases) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        SecureRelation result = c.op.execute(relation);
+        long long value = result.columns[0][0].reveal<int64_t>();
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+        std::cout << c.name << " over " << num_rows << " rows: " << value << " (expected " << c.expected << "), "
+                  << result.columns[0][0].size() << " bits, " << duration << " ms" << std::endl;
+        mismatches += value != c.expected;
+    }
+
+    // COUNT, SUM, MIN, MAX and AVG in one pass, sharing the conditioned rows, sum and count
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    MultiAggregateOperator multi_op({AggregateOperator(AggregateOperator::COUNT), SumOperator(1), MinOperator(1), MaxOperator(1), AvgOperator(1)});
+    SecureRelation multi_result = multi_op.execute(relation);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    multi_result.print_relation("Multi-aggregate (COUNT, SUM, MIN, MAX, AVG):");
+    std::cout << "Multi-aggregate over " << num_rows << " rows: " << duration << " ms" << std::endl;
+    for (size_t k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        mismatches += multi_result.columns[k][0].reveal<int64_t>() != cases[k].expected;
+    }
+
+    if (mismatches != 0) {
+        std::cerr << mismatches << " aggregates differ from the expected values" << std::endl;
+    }
+    delete io;
+    return mismatches == 0 ? 0 : 1;
+}
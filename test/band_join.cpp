@@ -0,0 +1,141 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "core/relation.hpp"
+#include "core/op_band_join.hpp"
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+
+using namespace emp;
+
+// Utility function to initialize a relation sorted on its first column, with values in [0, domain),
+// and a noisy index of the equal-width bins of that column: every non-empty bin range is widened
+// by up to noise rows on each side, so neighbouring ranges overlap. The real rows are kept in plaintext.
+Synopsis init_relation(SecureRelation& relation, int num_cols, int num_rows, int domain, int bins, int noise,
+                       std::vector<std::vector<int>>& real_rows, bool mixed_flags = false) {
+    std::vector<int> values(num_rows);
+    for (int row = 0; row < num_rows; ++row) {
+        values[row] = rand() % domain;
+    }
+    std::sort(values.begin(), values.end());
+
+    for (int row = 0; row < num_rows; ++row) {
+        std::vector<int> plain = {values[row]};
+        for (int col = 1; col < num_cols; ++col) {
+            plain.push_back(rand() % 100);
+        }
+        int flag = mixed_flags ? rand() % 2 : 1;
+        for (int col = 0; col < num_cols; ++col) {
+            relation.columns[col][row] = Integer(32, plain[col], ALICE);
+        }
+        relation.flags[row] = Integer(1, flag, ALICE);
+        if (flag) real_rows.push_back(plain);
+    }
+
+    int bin_width = domain / bins;
+    std::vector<std::pair<int, int>> index;
+    int row = 0;
+    for (int bin = 0; bin < bins; ++bin) {
+        int first = row;
+        while (row < num_rows && values[row] < (bin + 1) * bin_width) row++;
+        if (first > row - 1 || noise == 0) {
+            index.push_back({first, row - 1});
+        } else {
+            index.push_back({std::max(first - rand() % (noise + 1), 0), std::min(row - 1 + rand() % (noise + 1), num_rows - 1)});
+        }
+    }
+    return Synopsis(index, 0, bin_width);
+}
+
+// Plaintext band join of real rows: every pair with lower <= s[0] - r[0] <= upper, rows of r followed by rows of s
+std::vector<std::vector<int>> band_join_rows(const std::vector<std::vector<int>>& rows1, const std::vector<std::vector<int>>& rows2,
+                                             int lower, int upper) {
+    std::vector<std::vector<int>> result;
+    for (const auto& r : rows1) {
+        for (const auto& s : rows2) {
+            if (s[0] - r[0] < lower || s[0] - r[0] > upper) continue;
+            std::vector<int> row = r;
+            row.insert(row.end(), s.begin(), s.end());
+            result.push_back(row);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// Revealed real rows of a relation, sorted so that they compare as a multiset
+std::vector<std::vector<int>> real_rows(const SecureRelation& relation) {
+    std::vector<std::vector<int>> rows;
+    for (size_t row = 0; row < relation.flags.size(); ++row) {
+        if (relation.flags[row].reveal<int>() == 0) continue;
+        std::vector<int> values;
+        for (const auto& column : relation.columns) {
+            values.push_back(column[row].reveal<int>());
+        }
+        rows.push_back(values);
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    // Every in-band pair of real rows must appear exactly once, also the pairs inside the
+    // overlap of neighbouring noisy ranges
+    int mismatches = 0;
+    auto check = [&](const std::string& label, const SecureRelation& result, const std::vector<std::vector<int>>& expected) {
+        bool same = real_rows(result) == expected;
+        std::cout << label << ": " << expected.size() << " real rows, " << (same ? "match" : "MISMATCH") << std::endl;
+        mismatches += !same;
+    };
+
+    // Small relations with mixed flags: pairs with 0 <= value2 - value1 <= 3
+    std::vector<std::vector<int>> rows1, rows2;
+    SecureRelation relation1(2, 16);
+    Synopsis synopsis1 = init_relation(relation1, 2, 16, 20, 4, 3, rows1, true);
+    SecureRelation relation2(2, 16);
+    Synopsis synopsis2 = init_relation(relation2, 2, 16, 20, 4, 3, rows2, true);
+
+    BandJoinOperator band_small(0, 0, 0, 3, synopsis1, synopsis2);
+    check("Band join (small)", band_small.execute(relation1, relation2), band_join_rows(rows1, rows2, 0, 3));
+
+    // One bucket covering everything vs. 32 noisy bins, band of 30 on a domain of 3200 (e.g. days)
+    const int num_rows = 256;
+    std::vector<std::vector<int>> loan_rows, trans_rows;
+    SecureRelation loans(1, num_rows);
+    Synopsis loan_synopsis = init_relation(loans, 1, num_rows, 3200, 32, 4, loan_rows);
+    SecureRelation trans(1, num_rows);
+    Synopsis trans_synopsis = init_relation(trans, 1, num_rows, 3200, 32, 4, trans_rows);
+    std::vector<std::vector<int>> expected = band_join_rows(loan_rows, trans_rows, 0, 30);
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    Synopsis single1({ {0, num_rows - 1} }, 0, 3200);
+    Synopsis single2({ {0, num_rows - 1} }, 0, 3200);
+    BandJoinOperator band_full(0, 0, 0, 30, single1, single2, 4 * num_rows);
+    SecureRelation full_result = band_full.execute(loans, trans);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration_full = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Single Bucket Band Join Time: " << duration_full << " ms" << std::endl;
+    io->flush();
+    check("Single bucket band join", full_result, expected);
+
+    start_time = std::chrono::high_resolution_clock::now();
+
+    BandJoinOperator band_bucketed(0, 0, 0, 30, loan_synopsis, trans_synopsis, 128);
+    SecureRelation bucketed_result = band_bucketed.execute(loans, trans);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    auto duration_bucketed = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Bucketed Band Join Time: " << duration_bucketed << " ms" << std::endl;
+    io->flush();
+    check("Bucketed band join", bucketed_result, expected);
+
+    delete io;
+    return mismatches == 0 ? 0 : 1;
+}
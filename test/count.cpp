@@ -0,0 +1,41 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "core/relation.hpp"
+#include "core/op_agg_count.hpp"
+#include <iostream>
+#include <chrono>
+
+using namespace emp;
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    int mismatches = 0;
+    for (int num_rows : {1, 7, 1000, 100000}) {
+        SecureRelation relation(1, num_rows);
+        int expected = 0;
+        for (int row = 0; row < num_rows; ++row) {
+            int flag = rand() % 2;
+            expected += flag;
+            relation.flags[row] = Integer(1, flag, ALICE);
+        }
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        CountOperator count_op;
+        SecureRelation count_result = count_op.execute(relation);
+        int count = count_result.columns[0][0].reveal<int>();
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+        std::cout << "Count over " << num_rows << " rows: " << count << " (expected " << expected << "), "
+                  << duration << " ms" << std::endl;
+        mismatches += count != expected;
+    }
+
+    delete io;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "core/relation.hpp"
+#include "core/op_distinct.hpp"
+#include "core/op_agg_count.hpp"
+#include <iostream>
+#include <chrono>
+
+using namespace emp;
+
+// Utility function to initialize a relation with random keys and flag bits
+void init_relation(SecureRelation& relation, int num_cols, int num_rows, int key_range) {
+    for (int col = 0; col < num_cols; ++col) {
+        for (int row = 0; row < num_rows; ++row) {
+            relation.columns[col][row] = Integer(32, rand() % key_range, ALICE);
+        }
+    }
+    for (int row = 0; row < num_rows; ++row) {
+        relation.flags[row] = Integer(1, rand() % 2, ALICE);
+    }
+}
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    // Small relation, printed for inspection
+    SecureRelation relation(2, 16);
+    init_relation(relation, 2, 16, 4);
+    relation.print_relation("Relation:");
+
+    DistinctOperator distinct_op(0);
+    distinct_op.execute(relation).print_relation("Distinct on column 0:");
+
+    DistinctOperator composite_distinct_op(JoinKey({0, 1}, {2, 2}));
+    composite_distinct_op.execute(relation).print_relation("Distinct on (column 0, column 1):");
+
+    DistinctOperator resized_distinct_op(0, Synopsis(5));
+    resized_distinct_op.execute(relation).print_relation("Distinct on column 0, compacted to 5 rows:");
+
+    // Unsorted input vs. input already sorted on the key
+    SecureRelation large_relation(1, 4096);
+    init_relation(large_relation, 1, 4096, 500);
+    CountOperator count_op;
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    SecureRelation distinct_result = distinct_op.execute(large_relation);
+    SecureRelation count_result = count_op.execute(distinct_result);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Count distinct over 4096 unsorted rows: " << count_result.columns[0][0].reveal<int>() << ", " << duration << " ms" << std::endl;
+
+    large_relation.sort_by_column(0);
+    start_time = std::chrono::high_resolution_clock::now();
+
+    distinct_result = distinct_op.execute(large_relation);
+    count_result = count_op.execute(distinct_result);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Count distinct over 4096 sorted rows: " << count_result.columns[0][0].reveal<int>() << ", " << duration << " ms" << std::endl;
+
+    delete io;
+    return 0;
+}
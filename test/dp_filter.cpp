@@ -0,0 +1,72 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "core/relation.hpp"
+#include "core/op_filter.hpp"
+#include "core/op_dp_filter.hpp"
+#include <iostream>
+#include <chrono>
+
+using namespace emp;
+
+// Utility function to initialize a relation with random values and flag bits
+void init_relation(SecureRelation& relation, int num_cols, int num_rows, bool mixed_flags = false) {
+    for (int col = 0; col < num_cols; ++col) {
+        for (int row = 0; row < num_rows; ++row) {
+            relation.columns[col][row] = Integer(32, rand() % 1000, ALICE);  // Random values
+        }
+    }
+
+    for (int row = 0; row < num_rows; ++row) {
+        if (mixed_flags) {
+            relation.flags[row] = Integer(1, rand() % 2, ALICE);  // Random binary flags
+        } else {
+            relation.flags[row] = Integer(1, 1, ALICE);  // All flags set to 1
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    // Small relation, printed before and after the fused filter
+    SecureRelation relation_small(3, 16);
+    init_relation(relation_small, 3, 16, true);
+    relation_small.print_relation("Relation with mixed flags:");
+
+    DPFilterOperator filter_small(Predicate::compare(1, CompareOp::GT, 500), Synopsis(6));
+    SecureRelation filtered_small = filter_small.execute(relation_small);
+    filtered_small.print_relation("Filtered and DP resized relation (bound 6):");
+
+    // Filter followed by compaction vs. the fused operator
+    const int num_rows = 1 << 12;
+    const int noisy_bound = 1 << 8;
+    SecureRelation relation(3, num_rows);
+    init_relation(relation, 3, num_rows);
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    FilterOperator filter(1, 100, "lt");
+    SecureRelation filtered_relation = filter.execute(relation);
+    filtered_relation.compact(noisy_bound);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration_filter_compact = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Filter + Compact Time: " << duration_filter_compact << " ms" << std::endl;
+    io->flush();
+
+    start_time = std::chrono::high_resolution_clock::now();
+
+    DPFilterOperator dp_filter(Predicate::compare(1, CompareOp::LT, 100), Synopsis(noisy_bound));
+    SecureRelation dp_filtered_relation = dp_filter.execute(relation);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    auto duration_dp_filter = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Fused DP Filter Time: " << duration_dp_filter << " ms" << std::endl;
+    io->flush();
+
+    delete io;
+    return 0;
+}
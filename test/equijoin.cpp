@@ -65,6 +65,19 @@ int main(int argc, char** argv) {
     join_result_mixed.sort_by_flag();
     join_result_mixed.print_relation("Join Result Sorted by Flag (Mixed Flags):");
 
+    // Composite key on (column 0, column 1): both columns hold values below 100, so 7 bits
+    // each are packed into one 14-bit key and every pair costs a single equality
+    SecureRelation relation_composite(3, 16);
+    init_relation(relation_composite, 3, 16);
+    for (int row = 0; row < 16; ++row) {
+        relation_composite.columns[0][row] = Integer(32, row % 4, ALICE);
+    }
+    JoinKey composite_key({0, 1}, {7, 7});
+    EquiJoinOperator composite_join_op(composite_key, composite_key);
+    SecureRelation join_result_composite = composite_join_op.execute(relation_composite, relation_composite);
+    join_result_composite.sort_by_flag();
+    join_result_composite.print_relation("Join Result Sorted by Flag (Composite Key):");
+
 
     delete io;
     return 0;
@@ -1,8 +1,11 @@
 #include "emp-sh2pc/emp-sh2pc.h"
 #include "core/relation.hpp"
 #include "core/op_filter.hpp"
+#include "util/public_compare.hpp"
 #include <iostream>
 #include <chrono>
+#include <cstdint>
+#include <vector>
 
 using namespace emp;
 
@@ -26,6 +29,31 @@ int main(int argc, char** argv) {
     NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
     setup_semi_honest(io, party);
 
+    // The reduced constant-comparison circuits must agree with the generic Integer comparisons,
+    // which see the secret value and the constant sign-extended to 64 bits
+    const std::vector<int64_t> boundaries = {INT32_MIN, int64_t(INT32_MIN) + 1, -1000, -2, -1, 0, 1, 2, 500,
+                                             int64_t(INT32_MAX) - 1, INT32_MAX, int64_t(INT32_MAX) + 1,
+                                             int64_t(INT32_MIN) - 1, int64_t(1) << 40, -(int64_t(1) << 40)};
+    int mismatches = 0;
+    for (int64_t secret : boundaries) {
+        if (secret < INT32_MIN || secret > INT32_MAX) continue;
+        Integer x(32, secret, ALICE);
+        Integer wide_x = x;
+        wide_x.resize(64);
+        for (int64_t constant : boundaries) {
+            Integer wide_c(64, constant, PUBLIC);
+            mismatches += PublicCompare::equal(x, constant).reveal<bool>() != (wide_x == wide_c).reveal<bool>();
+            mismatches += PublicCompare::less_than(x, constant).reveal<bool>() != (wide_x < wide_c).reveal<bool>();
+            mismatches += PublicCompare::less_than(x, constant, true).reveal<bool>() != (wide_x <= wide_c).reveal<bool>();
+        }
+    }
+    if (mismatches != 0) {
+        std::cerr << "Public constant comparisons differ from the generic ones in " << mismatches << " cases" << std::endl;
+        delete io;
+        return 1;
+    }
+    std::cout << "Public constant comparisons match the generic ones" << std::endl;
+
     // Create and initialize a large relation
     const int num_cols = 3;  // 3 columns
     const int num_rows = 1 << 12;  // Around a million rows
@@ -43,6 +71,17 @@ int main(int argc, char** argv) {
     std::cout << "Filter by Fixed Value Time: " << duration_filter_by_fixed_value << " ms" << std::endl;
     io->flush();
 
+    start_time = std::chrono::high_resolution_clock::now();
+
+    // Same filter with a public constant, compiled to the reduced comparison circuit
+    FilterOperator filter_by_public_value(1, 500, "lt");
+    SecureRelation filtered_relation1_public = filter_by_public_value.execute(relation);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    auto duration_filter_by_public_value = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Filter by Public Value Time: " << duration_filter_by_public_value << " ms" << std::endl;
+    io->flush();
+
     SecureRelation relation2(num_cols, num_rows);
     init_relation(relation2, num_cols, num_rows);
 
@@ -75,6 +114,40 @@ int main(int argc, char** argv) {
     std::cout << "Two Times Selection Time: " << duration_two_times_filter << " ms" << std::endl;
     io->flush();
 
+    // Fused selection: range on one column AND an IN-list on another, in a single pass
+    SecureRelation relation4(num_cols, num_rows);
+    init_relation(relation4, num_cols, num_rows);
+
+    start_time = std::chrono::high_resolution_clock::now();
+
+    Predicate fused_predicate = Predicate::compare(0, CompareOp::GT, Integer(32, 300, ALICE))
+                              && Predicate::compare(0, CompareOp::LT, Integer(32, 700, ALICE))
+                              && Predicate::in_list(2, {Integer(32, 1, ALICE), Integer(32, 2, ALICE)});
+    FilterOperator fused_filter(fused_predicate);
+    SecureRelation filtered_relation4 = fused_filter.execute(relation4);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    auto duration_fused_filter = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Fused Predicate Selection Time: " << duration_fused_filter << " ms" << std::endl;
+    io->flush();
+
+#ifdef MULTI_THREAD
+    // Parallel selection: one chunk of rows per worker session
+    const int num_sessions = 4;
+    SessionPool pool(party, "127.0.0.1", port + 1, num_sessions);
+
+    start_time = std::chrono::high_resolution_clock::now();
+
+    FilterOperator parallel_filter(1, 500, "lt");
+    parallel_filter.set_parallel(&pool);
+    SecureRelation filtered_relation5 = parallel_filter.execute(relation);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    auto duration_parallel_filter = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Parallel Selection Time (" << num_sessions << " sessions): " << duration_parallel_filter << " ms" << std::endl;
+    io->flush();
+#endif
+
     delete io;
     return 0;
 }
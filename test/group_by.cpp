@@ -0,0 +1,61 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "core/relation.hpp"
+#include "core/op_agg_count.hpp"
+#include "core/op_group_by.hpp"
+#include <iostream>
+#include <chrono>
+
+using namespace emp;
+
+// Utility function to initialize a relation of (group key, value) rows with random flag bits
+void init_relation(SecureRelation& relation, int num_rows, int num_groups) {
+    for (int row = 0; row < num_rows; ++row) {
+        relation.columns[0][row] = Integer(32, rand() % num_groups, ALICE);
+        relation.columns[1][row] = Integer(32, rand() % 100, ALICE);
+        relation.flags[row] = Integer(1, rand() % 2, ALICE);
+    }
+}
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    // Small relation, printed for inspection
+    SecureRelation relation(2, 16);
+    init_relation(relation, 16, 4);
+    relation.print_relation("Relation (key, value):");
+
+    // Noisy group count above the 4 real groups
+    Synopsis synopsis(6);
+
+    GroupByOperator count_by_key(0, CountOperator(), synopsis);
+    count_by_key.execute(relation).print_relation("Group by key, count:");
+
+    GroupByOperator sum_by_key(0, SumOperator(1), synopsis);
+    sum_by_key.execute(relation).print_relation("Group by key, sum(value):");
+
+    GroupByOperator min_by_key(0, MinOperator(1), synopsis);
+    min_by_key.execute(relation).print_relation("Group by key, min(value):");
+
+    GroupByOperator max_by_key(0, MaxOperator(1), synopsis);
+    max_by_key.execute(relation).print_relation("Group by key, max(value):");
+
+    // Larger relation, timed
+    SecureRelation large_relation(2, 4096);
+    init_relation(large_relation, 4096, 100);
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    GroupByOperator large_count_by_key(0, CountOperator(), Synopsis(110));
+    SecureRelation large_result = large_count_by_key.execute(large_relation);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Group by over 4096 rows: " << duration << " ms (" << large_result.flags.size() << " rows)" << std::endl;
+
+    delete io;
+    return 0;
+}
@@ -65,6 +65,22 @@ int main(int argc, char** argv) {
     SecureRelation index_join_result_mf = index_join_op_mf.execute(relation1, relation2);
     index_join_result_mf.print_relation("Index Join Result (MF Compaction):");
 
+    // Per-bucket MF join: rows 4-5 of both relations lie in both buckets and are joined twice
+    IndexEquiJoinOperator per_bucket_join_op(index1, index2, 1, 1, IndexEquiJoinOperator::MF, 0, mf1, mf2);
+    per_bucket_join_op.set_overlap_aware(false);
+    SecureRelation per_bucket_join_result = per_bucket_join_op.execute(relation1, relation2);
+    per_bucket_join_result.print_relation("Index Join Result (MF Compaction, Per Bucket):");
+
+#ifdef MULTI_THREAD
+    // Parallel MF join: bucket pairs spread over the worker sessions
+    const int num_sessions = 2;
+    SessionPool pool(party, "127.0.0.1", port + 1, num_sessions);
+
+    IndexEquiJoinOperator parallel_join_op(index1, index2, 1, 1, IndexEquiJoinOperator::MF, 0, mf1, mf2);
+    parallel_join_op.set_parallel(&pool);
+    SecureRelation parallel_join_result = parallel_join_op.execute(relation1, relation2);
+    parallel_join_result.print_relation("Index Join Result (MF Compaction, " + std::to_string(num_sessions) + " sessions):");
+#endif
 
     delete io;
     return 0;
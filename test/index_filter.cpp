@@ -0,0 +1,109 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "core/relation.hpp"
+#include "core/op_filter.hpp"
+#include "core/op_idx_filter.hpp"
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+
+using namespace emp;
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    // Relation sorted on column 0, values in [0, 1000) except [400, 500)
+    const int num_rows = 1 << 12;
+    std::vector<int> values(num_rows);
+    for (int row = 0; row < num_rows; ++row) {
+        values[row] = rand() % 900;
+        values[row] += values[row] < 400 ? 0 : 100;
+    }
+    std::sort(values.begin(), values.end());
+
+    SecureRelation relation(2, num_rows);
+    for (int row = 0; row < num_rows; ++row) {
+        relation.columns[0][row] = Integer(32, values[row], ALICE);
+        relation.columns[1][row] = Integer(32, rand() % 1000, ALICE);
+        relation.flags[row] = Integer(1, 1, ALICE);
+    }
+
+    // Simulated noisy CDF index over 10 bins of width 100, widened by a random number of rows
+    // per side, so the ranges do not grow monotonically; the empty bin gets the range (0, -1)
+    std::vector<std::pair<int, int>> index;
+    for (int bin = 0; bin < 10; ++bin) {
+        int lo = std::lower_bound(values.begin(), values.end(), bin * 100) - values.begin();
+        int hi = std::lower_bound(values.begin(), values.end(), (bin + 1) * 100) - values.begin() - 1;
+        if (lo > hi) {
+            index.push_back({0, -1});
+        } else {
+            index.push_back({std::max(lo - rand() % 64, 0), std::min(hi + rand() % 64, num_rows - 1)});
+        }
+    }
+    Synopsis synopsis(index, 0, 100);
+
+    // Every flag of an index-filtered result must equal the full-scan flag of its row, and no
+    // row outside the scanned range may pass the full scan
+    int mismatches = 0;
+    auto check = [&](const SecureRelation& scanned, const SecureRelation& index_filtered, int64_t lower, int64_t upper) {
+        std::pair<int, int> range = synopsis.covering_range(lower, upper);
+        int first = std::max(range.first, 0);
+        for (int row = 0; row < num_rows; ++row) {
+            bool expected = scanned.flags[row].reveal<int>() != 0;
+            int offset = row - first;
+            if (offset >= 0 && offset < static_cast<int>(index_filtered.flags.size())) {
+                mismatches += (index_filtered.flags[offset].reveal<int>() != 0) != expected;
+            } else {
+                mismatches += expected;
+            }
+        }
+    };
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // Full scan
+    FilterOperator scan_filter(Predicate::between(0, 250, 320));
+    SecureRelation scanned_relation = scan_filter.execute(relation);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration_scan = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Full Scan Selection Time: " << duration_scan << " ms, output rows: " << scanned_relation.flags.size() << std::endl;
+    io->flush();
+
+    start_time = std::chrono::high_resolution_clock::now();
+
+    // Index-assisted scan of the covering DP ranges only
+    IndexFilterOperator index_filter(0, 250, 320, synopsis);
+    SecureRelation index_filtered_relation = index_filter.execute(relation);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    auto duration_index = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Index Selection Time: " << duration_index << " ms, output rows: " << index_filtered_relation.flags.size() << std::endl;
+    io->flush();
+    check(scanned_relation, index_filtered_relation, 250, 320);
+
+    start_time = std::chrono::high_resolution_clock::now();
+
+    // Index-assisted scan with a residual predicate on another column
+    IndexFilterOperator index_filter_residual(0, 250, 320, synopsis, Predicate::compare(1, CompareOp::LT, 500));
+    SecureRelation index_filtered_residual = index_filter_residual.execute(relation);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    auto duration_residual = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Index Selection + Residual Time: " << duration_residual << " ms, output rows: " << index_filtered_residual.flags.size() << std::endl;
+    io->flush();
+    check(FilterOperator(Predicate::between(0, 250, 320) && Predicate::compare(1, CompareOp::LT, 500)).execute(relation),
+          index_filtered_residual, 250, 320);
+
+    // A range ending in the empty bin
+    check(FilterOperator(Predicate::between(0, 250, 450)).execute(relation),
+          IndexFilterOperator(0, 250, 450, synopsis).execute(relation), 250, 450);
+
+    std::cout << "Mismatched rows: " << mismatches << std::endl;
+
+    delete io;
+    return mismatches == 0 ? 0 : 1;
+}
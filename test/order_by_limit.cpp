@@ -0,0 +1,120 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "core/relation.hpp"
+#include "core/op_order_by.hpp"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <chrono>
+
+using namespace emp;
+
+// Utility function to initialize a relation with random values and flag bits; returns the
+// values of column key_column in the real rows
+std::vector<int> init_relation(SecureRelation& relation, int num_cols, int num_rows, int value_range, int key_column = 0) {
+    std::vector<int> values(num_rows);
+    for (int col = 0; col < num_cols; ++col) {
+        for (int row = 0; row < num_rows; ++row) {
+            int value = rand() % value_range;
+            relation.columns[col][row] = Integer(32, value, ALICE);
+            if (col == key_column) values[row] = value;
+        }
+    }
+    std::vector<int> real_keys;
+    for (int row = 0; row < num_rows; ++row) {
+        int flag = rand() % 2;
+        relation.flags[row] = Integer(1, flag, ALICE);
+        if (flag) real_keys.push_back(values[row]);
+    }
+    return real_keys;
+}
+
+// Number of rows of an ORDER BY result that differ from a plaintext sort of the real keys:
+// the first min(k, real rows) rows are real and hold the top keys in order, the rest are dummies
+int count_mismatches(const SecureRelation& result, int key_column, std::vector<int> real_keys, int limit, bool ascending) {
+    if (ascending) {
+        std::sort(real_keys.begin(), real_keys.end());
+    } else {
+        std::sort(real_keys.begin(), real_keys.end(), std::greater<int>());
+    }
+    if (static_cast<int>(result.flags.size()) != limit) {
+        return limit;
+    }
+    int mismatches = 0;
+    for (int row = 0; row < limit; ++row) {
+        bool real = result.flags[row].reveal<int>() != 0;
+        if (row < static_cast<int>(real_keys.size())) {
+            mismatches += !real || result.columns[key_column][row].reveal<int>() != real_keys[row];
+        } else {
+            mismatches += real;
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    int mismatches = 0;
+    auto check = [&](const std::string& label, const SecureRelation& relation, int key_column, const std::vector<int>& real_keys, int limit, bool ascending) {
+        int rows = count_mismatches(OrderByLimitOperator(key_column, limit, ascending).execute(relation), key_column, real_keys, limit, ascending);
+        std::cout << label << ": " << rows << " mismatched rows" << std::endl;
+        mismatches += rows;
+    };
+
+    // Small relation: one block, k not a power of two, and k above the number of real rows
+    SecureRelation relation(2, 16);
+    std::vector<int> keys = init_relation(relation, 2, 16, 100, 1);
+    check("Order by column 1 limit 5", relation, 1, keys, 5, true);
+    check("Order by column 1 desc limit 5", relation, 1, keys, 5, false);
+    check("Order by column 1 limit 20", relation, 1, keys, 20, true);
+
+    // More rows than the block of k rows: the streamed top-k selection
+    SecureRelation streamed_relation(2, 100);
+    std::vector<int> streamed_keys = init_relation(streamed_relation, 2, 100, 1000, 0);
+    check("Order by column 0 limit 7 over 100 rows", streamed_relation, 0, streamed_keys, 7, true);
+    check("Order by column 0 desc limit 7 over 100 rows", streamed_relation, 0, streamed_keys, 7, false);
+
+    // Ordering columns wider than 62 bits are rejected
+    SecureRelation wide_relation(1, 4);
+    for (int row = 0; row < 4; ++row) {
+        wide_relation.columns[0][row] = Integer(64, row, ALICE);
+        wide_relation.flags[row] = Integer(1, 1, ALICE);
+    }
+    try {
+        OrderByLimitOperator(0, 2).execute(wide_relation);
+        std::cout << "Order by a 64-bit column: not rejected" << std::endl;
+        mismatches++;
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Order by a 64-bit column: " << e.what() << std::endl;
+    }
+
+    // Top-k selection vs. a full sort
+    SecureRelation large_relation(1, 4096);
+    std::vector<int> large_keys = init_relation(large_relation, 1, 4096, 100000);
+    OrderByLimitOperator large_top_op(0, 10);
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    SecureRelation top_result = large_top_op.execute(large_relation);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Order by limit 10 over 4096 rows: " << duration << " ms" << std::endl;
+    mismatches += count_mismatches(top_result, 0, large_keys, 10, true);
+
+    start_time = std::chrono::high_resolution_clock::now();
+
+    large_relation.sort_by_column(0);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Full sort of 4096 rows: " << duration << " ms" << std::endl;
+
+    delete io;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -1,38 +1,75 @@
 #include "emp-sh2pc/emp-sh2pc.h"
 #include "core/relation.hpp"
 #include "core/op_pac_filter.hpp"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 
 using namespace emp;
 
-// Utility function to initialize a relation with random values and flag bits
-void init_relation(SecureRelation& relation, int num_cols, int num_rows, bool mixed_flags = false) {
+// Plaintext rows of a relation: values, and the flag as 0/1
+struct PlainRelation {
+    std::vector<std::vector<int>> columns;
+    std::vector<int> flags;
+};
+
+// Random values in [0, 1000); flags all 1, or random when mixed_flags is set
+PlainRelation init_relation(SecureRelation& relation, int num_cols, int num_rows, bool mixed_flags = false) {
+    PlainRelation plain{std::vector<std::vector<int>>(num_cols, std::vector<int>(num_rows)), std::vector<int>(num_rows)};
     for (int col = 0; col < num_cols; ++col) {
         for (int row = 0; row < num_rows; ++row) {
-            relation.columns[col][row] = Integer(32, rand() % 1000, ALICE);  // Random values
+            plain.columns[col][row] = rand() % 1000;
+            relation.columns[col][row] = Integer(32, plain.columns[col][row], ALICE);
         }
     }
 
     for (int row = 0; row < num_rows; ++row) {
-        if (mixed_flags) {
-            relation.flags[row] = Integer(1, rand() % 2, ALICE);  // Random binary flags
-        } else {
-            relation.flags[row] = Integer(1, 1, ALICE);  // All flags set to 1
+        plain.flags[row] = mixed_flags ? rand() % 2 : 1;
+        relation.flags[row] = Integer(1, plain.flags[row], ALICE);
+    }
+    return plain;
+}
+
+// Slot-writing PAC filter on plaintext rows: the j-th real row with column > target goes to
+// slot j while j < truncation_size; every other slot is a dummy holding zeros
+PlainRelation pac_filter_model(const PlainRelation& input, int column_index, int target, int truncation_size) {
+    int num_cols = input.columns.size();
+    PlainRelation output{std::vector<std::vector<int>>(num_cols, std::vector<int>(truncation_size, 0)), std::vector<int>(truncation_size, 0)};
+    int written = 0;
+    for (size_t row = 0; row < input.flags.size() && written < truncation_size; ++row) {
+        if (input.flags[row] && input.columns[column_index][row] > target) {
+            for (int col = 0; col < num_cols; ++col) {
+                output.columns[col][written] = input.columns[col][row];
+            }
+            output.flags[written++] = 1;
         }
     }
+    return output;
 }
 
-// Utility function to print the relation's details
-void print_relation(const std::string& label, const SecureRelation& relation) {
-    std::cout << label << "\n";
-    for (size_t row = 0; row < relation.columns[0].size(); ++row) {
-        for (size_t col = 0; col < relation.columns.size(); ++col) {
-            std::cout << relation.columns[col][row].reveal<int>() << "\t";
+// Number of slots of the revealed filter output that differ from the model
+int count_mismatches(const SecureRelation& output, const PlainRelation& expected) {
+    if (output.flags.size() != expected.flags.size()) {
+        return std::max(output.flags.size(), expected.flags.size());
+    }
+    int mismatches = 0;
+    for (size_t row = 0; row < expected.flags.size(); ++row) {
+        bool same = (output.flags[row].reveal<int>() != 0) == (expected.flags[row] != 0);
+        for (size_t col = 0; col < expected.columns.size(); ++col) {
+            same = same && output.columns[col][row].reveal<int>() == expected.columns[col][row];
         }
-        std::cout << "| Flag: " << relation.flags[row].reveal<int>() << "\n";
+        mismatches += !same;
     }
-    std::cout << "\n";
+    return mismatches;
+}
+
+// Number of qualifying rows of the model filter, column > target on real rows
+int count_matches(const PlainRelation& input, int column_index, int target) {
+    int matches = 0;
+    for (size_t row = 0; row < input.flags.size(); ++row) {
+        matches += input.flags[row] && input.columns[column_index][row] > target;
+    }
+    return matches;
 }
 
 int main(int argc, char** argv) {
@@ -42,26 +79,38 @@ int main(int argc, char** argv) {
     NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
     setup_semi_honest(io, party);
 
-    // Create and initialize a relation with all flags set to 1
-    SecureRelation relation_all_one(3, 16);
-    init_relation(relation_all_one, 3, 16);
+    int mismatches = 0;
 
-    print_relation("Relation with all flags set to 1:", relation_all_one);
+    // All flags set to 1, and mixed flags; truncation below and above the number of matches
+    for (bool mixed_flags : {false, true}) {
+        SecureRelation relation(3, 16);
+        PlainRelation plain = init_relation(relation, 3, 16, mixed_flags);
+        int matches = count_matches(plain, 1, 500);
+        for (int truncation_size : {std::max(matches / 2, 1), matches + 5}) {
+            PACFilterOperator filter(1, Integer(32, 500, ALICE), "gt", truncation_size);
+            int slots = count_mismatches(filter.execute(relation), pac_filter_model(plain, 1, 500, truncation_size));
+            std::cout << "PAC Filter (" << (mixed_flags ? "mixed flags" : "all flags 1") << ", " << matches << " matches, truncation "
+                      << truncation_size << "): " << slots << " mismatched slots" << std::endl;
+            mismatches += slots;
+        }
+    }
 
-    PACFilterOperator filter_all_one(1, Integer(32, 500, ALICE), "gt", 10);
-    SecureRelation filtered_relation_all_one = filter_all_one.execute(relation_all_one);
-    print_relation("Filtered Relation (All Flags 1):", filtered_relation_all_one);
+    // Larger relation with a large truncation size, timed
+    const int num_rows = 1 << 12;
+    const int truncation_size = 1 << 10;
+    SecureRelation relation_large(3, num_rows);
+    PlainRelation plain_large = init_relation(relation_large, 3, num_rows, true);
 
-    // Create and initialize a relation with mixed flags
-    SecureRelation relation_mixed_flags(3, 16);
-    init_relation(relation_mixed_flags, 3, 16, true);
+    auto start_time = std::chrono::high_resolution_clock::now();
 
-    print_relation("Relation with mixed flags:", relation_mixed_flags);
+    PACFilterOperator filter_large(1, 500, "gt", truncation_size);
+    SecureRelation filtered_relation_large = filter_large.execute(relation_large);
 
-    PACFilterOperator filter_mixed_flags(1, Integer(32, 500, ALICE), "gt", 10);
-    SecureRelation filtered_relation_mixed = filter_mixed_flags.execute(relation_mixed_flags);
-    print_relation("Filtered Relation (Mixed Flags):", filtered_relation_mixed);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration_large = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "PAC Filter Time (" << num_rows << " rows, truncation " << truncation_size << "): " << duration_large << " ms" << std::endl;
+    mismatches += count_mismatches(filtered_relation_large, pac_filter_model(plain_large, 1, 500, truncation_size));
 
     delete io;
-    return 0;
+    return mismatches == 0 ? 0 : 1;
 }
@@ -0,0 +1,103 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "util/prefix_scan.hpp"
+#include "core/op_group_by.hpp"
+#include "core/op_agg_count.hpp"
+#include <iostream>
+#include <chrono>
+
+using namespace emp;
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    // Small input, printed for inspection: running sums restarting at every head
+    const int num_rows = 16;
+    std::vector<Integer> values(num_rows);
+    std::vector<Bit> heads(num_rows);
+    for (int row = 0; row < num_rows; ++row) {
+        values[row] = Integer(32, rand() % 10, ALICE);
+        heads[row] = Bit(row == 0 || rand() % 4 == 0, ALICE);
+    }
+    std::vector<Integer> sums = values;
+    std::vector<Integer> segment_sums = values;
+    PrefixScan::inclusive_scan(sums, PrefixScan::add);
+    PrefixScan::segmented_scan(segment_sums, heads, PrefixScan::add);
+
+    std::cout << "value\thead\tprefix sum\tsegmented sum\n";
+    for (int row = 0; row < num_rows; ++row) {
+        std::cout << values[row].reveal<int>() << "\t" << heads[row].reveal<bool>() << "\t"
+                  << sums[row].reveal<int>() << "\t\t" << segment_sums[row].reveal<int>() << "\n";
+    }
+    std::cout << std::endl;
+
+    // Larger input, timed
+    std::vector<Integer> large_values(100000);
+    for (auto& value : large_values) {
+        value = Integer(32, rand() % 10, ALICE);
+    }
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    PrefixScan::inclusive_scan(large_values, PrefixScan::add);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Prefix sum over " << large_values.size() << " values: " << duration << " ms" << std::endl;
+
+#ifdef MULTI_THREAD
+    // The levels split over a pool must give the same scans as the serial form
+    const int num_sessions = 4;
+    SessionPool pool(party, "127.0.0.1", port + 1, num_sessions);
+
+    std::vector<Integer> parallel_sums = values;
+    std::vector<Integer> parallel_segment_sums = values;
+    PrefixScan::inclusive_scan(parallel_sums, PrefixScan::add, &pool);
+    PrefixScan::segmented_scan(parallel_segment_sums, heads, PrefixScan::add, &pool);
+
+    int mismatches = 0;
+    for (int row = 0; row < num_rows; ++row) {
+        mismatches += parallel_sums[row].reveal<int>() != sums[row].reveal<int>();
+        mismatches += parallel_segment_sums[row].reveal<int>() != segment_sums[row].reveal<int>();
+    }
+
+    // Group by over the pool against the serial operator
+    SecureRelation relation(2, 4096);
+    for (int row = 0; row < 4096; ++row) {
+        relation.columns[0][row] = Integer(32, rand() % 50, ALICE);
+        relation.columns[1][row] = Integer(32, rand() % 10, ALICE);
+        relation.flags[row] = Integer(1, rand() % 2, ALICE);
+    }
+    GroupByOperator group_by_op(0, CountOperator(), Synopsis(50));
+    SecureRelation serial_groups = group_by_op.execute(relation);
+
+    start_time = std::chrono::high_resolution_clock::now();
+
+    group_by_op.set_parallel(&pool);
+    SecureRelation parallel_groups = group_by_op.execute(relation);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Parallel group by count over 4096 rows (" << num_sessions << " sessions): " << duration << " ms" << std::endl;
+
+    for (size_t row = 0; row < serial_groups.flags.size(); ++row) {
+        for (int col = 0; col < 2; ++col) {
+            mismatches += serial_groups.columns[col][row].reveal<int>() != parallel_groups.columns[col][row].reveal<int>();
+        }
+        mismatches += serial_groups.flags[row].reveal<int>() != parallel_groups.flags[row].reveal<int>();
+    }
+    io->flush();
+
+    if (mismatches != 0) {
+        std::cerr << "Parallel scans differ from the serial ones in " << mismatches << " values" << std::endl;
+        delete io;
+        return 1;
+    }
+#endif
+
+    delete io;
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "core/relation.hpp"
+#include "core/op_idx_equijoin.hpp"
+#include "core/op_semijoin.hpp"
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+
+using namespace emp;
+
+// Utility function to initialize a relation with a sorted key column and random flag bits;
+// returns the sorted keys, and real_keys gets the keys with -1 for dummy rows
+std::vector<int> init_relation(SecureRelation& relation, int num_cols, int num_rows, int key_range, std::vector<int>& real_keys,
+                               bool mixed_flags = false) {
+    std::vector<int> keys(num_rows);
+    for (int row = 0; row < num_rows; ++row) {
+        keys[row] = rand() % key_range;
+    }
+    std::sort(keys.begin(), keys.end());
+
+    real_keys.assign(num_rows, -1);
+    for (int row = 0; row < num_rows; ++row) {
+        relation.columns[0][row] = Integer(32, keys[row], ALICE);
+        for (int col = 1; col < num_cols; ++col) {
+            relation.columns[col][row] = Integer(32, rand() % 100, ALICE);
+        }
+        int flag = mixed_flags ? rand() % 2 : 1;
+        relation.flags[row] = Integer(1, flag, ALICE);
+        real_keys[row] = flag ? keys[row] : -1;
+    }
+    return keys;
+}
+
+// Two buckets splitting the key range in half, each widened by overlap rows into the other
+// half, like noisy DP ranges
+std::vector<std::pair<int, int>> halves(const std::vector<int>& keys, int key_range, int overlap) {
+    int num_rows = keys.size();
+    int split = std::lower_bound(keys.begin(), keys.end(), key_range / 2) - keys.begin();
+    return { {0, std::min(split - 1 + overlap, num_rows - 1)}, {std::max(split - overlap, 0), num_rows - 1} };
+}
+
+// Rows whose flag differs from real && some real row of the right relation has the same key
+int count_mismatches(const SecureRelation& result, const std::vector<int>& left_keys, const std::vector<int>& right_keys) {
+    int mismatches = 0;
+    for (size_t row = 0; row < left_keys.size(); ++row) {
+        bool expected = left_keys[row] >= 0 && std::find(right_keys.begin(), right_keys.end(), left_keys[row]) != right_keys.end();
+        mismatches += (result.flags[row].reveal<int>() != 0) != expected;
+    }
+    return mismatches;
+}
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    int mismatches = 0;
+
+    // Small relations with mixed flags, one bucket
+    std::vector<int> keys1, keys2;
+    SecureRelation relation1(2, 8);
+    init_relation(relation1, 2, 8, 10, keys1, true);
+    SecureRelation relation2(1, 8);
+    init_relation(relation2, 1, 8, 10, keys2, true);
+
+    SemiJoinOperator semi_join(0, 0);
+    int small_mismatches = count_mismatches(semi_join.execute(relation1, relation2), keys1, keys2);
+    std::cout << "Semi-join: " << small_mismatches << " mismatched flags" << std::endl;
+    mismatches += small_mismatches;
+
+    // Bucketed equijoin vs. bucketed semi-join over the same DP indexes; the buckets overlap,
+    // so the rows in the overlap are compared by both buckets
+    std::vector<int> left_keys, right_keys;
+    SecureRelation left(1, 256);
+    std::vector<std::pair<int, int>> index_left = halves(init_relation(left, 1, 256, 64, left_keys, true), 64, 8);
+    SecureRelation right(1, 64);
+    std::vector<std::pair<int, int>> index_right = halves(init_relation(right, 1, 64, 64, right_keys, true), 64, 4);
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    IndexEquiJoinOperator index_join(index_left, index_right, 0, 0);
+    SecureRelation join_result = index_join.execute(left, right);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration_join = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Index Join Time: " << duration_join << " ms (" << join_result.flags.size() << " rows)" << std::endl;
+    io->flush();
+
+    start_time = std::chrono::high_resolution_clock::now();
+
+    SemiJoinOperator index_semi_join(index_left, index_right, 0, 0);
+    SecureRelation semi_join_result = index_semi_join.execute(left, right);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    auto duration_semi_join = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Index Semi-Join Time: " << duration_semi_join << " ms (" << semi_join_result.flags.size() << " rows)" << std::endl;
+    io->flush();
+
+    int index_mismatches = count_mismatches(semi_join_result, left_keys, right_keys);
+    std::cout << "Index semi-join: " << index_mismatches << " mismatched flags" << std::endl;
+    mismatches += index_mismatches;
+
+    delete io;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "core/relation.hpp"
+#include "core/op_equijoin.hpp"
+#include "core/op_sort_equijoin.hpp"
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+
+using namespace emp;
+
+// Utility function to initialize a relation whose first column is a unique key
+void init_pk_relation(SecureRelation& relation, int num_cols, int num_rows, bool mixed_flags = false) {
+    for (int row = 0; row < num_rows; ++row) {
+        relation.columns[0][row] = Integer(32, row, ALICE);  // Primary key
+        for (int col = 1; col < num_cols; ++col) {
+            relation.columns[col][row] = Integer(32, rand() % 100, ALICE);
+        }
+        relation.flags[row] = Integer(1, mixed_flags ? rand() % 2 : 1, ALICE);
+    }
+}
+
+// Utility function to initialize a relation with random values and flag bits
+void init_relation(SecureRelation& relation, int num_cols, int num_rows, int key_range, bool mixed_flags = false) {
+    for (int col = 0; col < num_cols; ++col) {
+        for (int row = 0; row < num_rows; ++row) {
+            relation.columns[col][row] = Integer(32, rand() % key_range, ALICE);
+        }
+    }
+
+    for (int row = 0; row < num_rows; ++row) {
+        relation.flags[row] = Integer(1, mixed_flags ? rand() % 2 : 1, ALICE);
+    }
+}
+
+// Revealed real rows of a relation, sorted so that two join results compare as multisets
+std::vector<std::vector<int>> real_rows(const SecureRelation& relation) {
+    std::vector<std::vector<int>> rows;
+    for (size_t row = 0; row < relation.flags.size(); ++row) {
+        if (relation.flags[row].reveal<int>() == 0) continue;
+        std::vector<int> values;
+        for (const auto& column : relation.columns) {
+            values.push_back(column[row].reveal<int>());
+        }
+        rows.push_back(values);
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    // The sort-merge join must return the real rows of the nested-loop join, as a multiset
+    int mismatches = 0;
+    auto check = [&](const std::string& label, const SecureRelation& sort_result, const SecureRelation& nested_result) {
+        std::vector<std::vector<int>> expected = real_rows(nested_result);
+        bool same = real_rows(sort_result) == expected;
+        std::cout << label << ": " << expected.size() << " real rows, " << (same ? "match" : "MISMATCH") << std::endl;
+        mismatches += !same;
+    };
+
+    // PK-FK join on small relations with mixed flags
+    SecureRelation pk_relation(2, 16);
+    init_pk_relation(pk_relation, 2, 16, true);
+    SecureRelation fk_relation(2, 24);
+    init_relation(fk_relation, 2, 24, 8, true);
+
+    SortMergeJoinOperator sort_join(0, 1);
+    check("Sort-merge join (PK-FK)", sort_join.execute(pk_relation, fk_relation), EquiJoinOperator(0, 1).execute(pk_relation, fk_relation));
+
+    // Left side with each key at most twice
+    SecureRelation dup_relation(2, 16);
+    init_relation(dup_relation, 2, 16, 100, true);
+    for (int row = 0; row < 16; ++row) {
+        dup_relation.columns[0][row] = Integer(32, row / 2, ALICE);
+    }
+    SortMergeJoinOperator sort_join_mf(0, 1, 2);
+    check("Sort-merge join (multiplicity 2)", sort_join_mf.execute(dup_relation, fk_relation), EquiJoinOperator(0, 1).execute(dup_relation, fk_relation));
+
+    // Nested-loop join vs. sort-merge join on a PK-FK workload
+    const int num_rows = 1 << 8;
+    SecureRelation pk_large(2, num_rows);
+    init_pk_relation(pk_large, 2, num_rows);
+    SecureRelation fk_large(2, num_rows);
+    init_relation(fk_large, 2, num_rows, num_rows);
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    EquiJoinOperator nested_join(0, 1);
+    SecureRelation nested_result = nested_join.execute(pk_large, fk_large);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration_nested = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Nested-Loop Join Time: " << duration_nested << " ms" << std::endl;
+    io->flush();
+
+    start_time = std::chrono::high_resolution_clock::now();
+
+    SecureRelation sorted_result = sort_join.execute(pk_large, fk_large);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    auto duration_sorted = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Sort-Merge Join Time: " << duration_sorted << " ms" << std::endl;
+    io->flush();
+    check("Sort-merge join (PK-FK, " + std::to_string(num_rows) + " rows)", sorted_result, nested_result);
+
+    delete io;
+    return mismatches == 0 ? 0 : 1;
+}
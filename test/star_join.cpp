@@ -0,0 +1,128 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "core/relation.hpp"
+#include "core/op_idx_equijoin.hpp"
+#include "core/op_star_join.hpp"
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+
+using namespace emp;
+
+// Utility function to initialize a relation whose first column is a sorted key with the given multiplicity;
+// returns the real rows in plaintext
+std::vector<std::vector<int>> init_relation(SecureRelation& relation, int num_cols, int num_rows, int mf, bool mixed_flags = false) {
+    std::vector<std::vector<int>> real_rows;
+    for (int row = 0; row < num_rows; ++row) {
+        std::vector<int> values = {row / mf};
+        for (int col = 1; col < num_cols; ++col) {
+            values.push_back(rand() % 100);
+        }
+        int flag = mixed_flags ? rand() % 2 : 1;
+        for (int col = 0; col < num_cols; ++col) {
+            relation.columns[col][row] = Integer(32, values[col], ALICE);
+        }
+        relation.flags[row] = Integer(1, flag, ALICE);
+        if (flag) real_rows.push_back(values);
+    }
+    return real_rows;
+}
+
+// Two buckets splitting the keys of a relation in half, each widened by overlap keys into
+// the other half, like noisy DP ranges
+std::vector<std::pair<int, int>> halves(int num_rows, int mf, int overlap) {
+    return { {0, num_rows / 2 - 1 + overlap * mf}, {num_rows / 2 - overlap * mf, num_rows - 1} };
+}
+
+// Plaintext equijoin of real rows on their first columns, rows of left followed by rows of right
+std::vector<std::vector<int>> join_rows(const std::vector<std::vector<int>>& left, const std::vector<std::vector<int>>& right) {
+    std::vector<std::vector<int>> result;
+    for (const auto& l : left) {
+        for (const auto& r : right) {
+            if (l[0] != r[0]) continue;
+            std::vector<int> row = l;
+            row.insert(row.end(), r.begin(), r.end());
+            result.push_back(row);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// Revealed real rows of a relation, sorted so that they compare as a multiset
+std::vector<std::vector<int>> real_rows(const SecureRelation& relation) {
+    std::vector<std::vector<int>> rows;
+    for (size_t row = 0; row < relation.flags.size(); ++row) {
+        if (relation.flags[row].reveal<int>() == 0) continue;
+        std::vector<int> values;
+        for (const auto& column : relation.columns) {
+            values.push_back(column[row].reveal<int>());
+        }
+        rows.push_back(values);
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    // Every join must return each real row combination of the plaintext 3-way join exactly once,
+    // also for the combinations inside the overlap of the two buckets
+    int mismatches = 0;
+    auto check = [&](const std::string& label, const SecureRelation& result, const std::vector<std::vector<int>>& expected) {
+        bool same = real_rows(result) == expected;
+        std::cout << label << ": " << expected.size() << " real rows, " << (same ? "match" : "MISMATCH") << std::endl;
+        mismatches += !same;
+    };
+
+    // Three small relations on keys 0..7 with mixed flags, buckets overlapping by 2 keys
+    SecureRelation relationA(2, 8);
+    auto rowsA = init_relation(relationA, 2, 8, 1, true);
+    SecureRelation relationB(2, 16);
+    auto rowsB = init_relation(relationB, 2, 16, 2, true);
+    SecureRelation relationC(2, 16);
+    auto rowsC = init_relation(relationC, 2, 16, 2, true);
+
+    StarJoinOperator star_small({halves(8, 1, 2), halves(16, 2, 2), halves(16, 2, 2)}, {0, 0, 0}, {1, 2, 2});
+    check("Star join (small)", star_small.execute({relationA, relationB, relationC}), join_rows(join_rows(rowsA, rowsB), rowsC));
+
+    // Chain of index joins vs. the star join, buckets overlapping by 4 keys
+    SecureRelation largeA(1, 64);
+    auto rows_largeA = init_relation(largeA, 1, 64, 1);
+    SecureRelation largeB(1, 128);
+    auto rows_largeB = init_relation(largeB, 1, 128, 2);
+    SecureRelation largeC(1, 256);
+    auto rows_largeC = init_relation(largeC, 1, 256, 4);
+    std::vector<std::vector<int>> expected_large = join_rows(join_rows(rows_largeA, rows_largeB), rows_largeC);
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    IndexEquiJoinOperator index_join_op(halves(64, 1, 4), halves(128, 2, 4), 0, 0, IndexEquiJoinOperator::MF, 0, 1, 2);
+    SecureRelation chain_result = index_join_op.execute(largeA, largeB);
+    IndexEquiJoinOperator index_join_op_2(index_join_op.output_index, halves(256, 4, 4), 0, 0, IndexEquiJoinOperator::MF, 0, 2, 4);
+    chain_result = index_join_op_2.execute(chain_result, largeC);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration_chain = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Index Join Chain Time: " << duration_chain << " ms" << std::endl;
+    io->flush();
+    check("Index join chain", chain_result, expected_large);
+
+    start_time = std::chrono::high_resolution_clock::now();
+
+    StarJoinOperator star_join_op({halves(64, 1, 4), halves(128, 2, 4), halves(256, 4, 4)}, {0, 0, 0}, {1, 2, 4});
+    SecureRelation star_large = star_join_op.execute({largeA, largeB, largeC});
+
+    end_time = std::chrono::high_resolution_clock::now();
+    auto duration_star = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Star Join Time: " << duration_star << " ms" << std::endl;
+    io->flush();
+    check("Star join", star_large, expected_large);
+
+    delete io;
+    return mismatches == 0 ? 0 : 1;
+}
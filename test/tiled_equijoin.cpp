@@ -0,0 +1,75 @@
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "core/relation.hpp"
+#include "core/op_equijoin.hpp"
+#include "core/op_tiled_equijoin.hpp"
+#include <iostream>
+#include <chrono>
+
+using namespace emp;
+
+// Utility function to initialize a relation with random values and flag bits
+void init_relation(SecureRelation& relation, int num_cols, int num_rows, int key_range, bool mixed_flags = false) {
+    for (int col = 0; col < num_cols; ++col) {
+        for (int row = 0; row < num_rows; ++row) {
+            relation.columns[col][row] = Integer(32, rand() % key_range, ALICE);
+        }
+    }
+
+    for (int row = 0; row < num_rows; ++row) {
+        relation.flags[row] = Integer(1, mixed_flags ? rand() % 2 : 1, ALICE);
+    }
+}
+
+int main(int argc, char** argv) {
+    int port, party;
+    parse_party_and_port(argv, &party, &port);
+
+    NetIO* io = new NetIO(party == ALICE ? nullptr : "127.0.0.1", port);
+    setup_semi_honest(io, party);
+
+    // Small relations, printed for inspection
+    SecureRelation relation1(2, 8);
+    init_relation(relation1, 2, 8, 10, true);
+    relation1.print_relation("First relation:");
+
+    SecureRelation relation2(2, 8);
+    init_relation(relation2, 2, 8, 10, true);
+    relation2.print_relation("Second relation:");
+
+    TiledEquiJoinOperator tiled_small(0, 0, 8, 4);
+    SecureRelation tiled_result = tiled_small.execute(relation1, relation2);
+    tiled_result.print_relation("Tiled join result (8 rows, tiles of 4):");
+
+    // Full join followed by compaction vs. the tiled join, as in a skewed DP bucket
+    const int rows1 = 512;
+    const int rows2 = 16;
+    const int output_size = rows1;
+    SecureRelation bucket1(2, rows1);
+    init_relation(bucket1, 2, rows1, 256);
+    SecureRelation bucket2(2, rows2);
+    init_relation(bucket2, 2, rows2, 256);
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    EquiJoinOperator join(0, 0);
+    SecureRelation join_result = join.execute(bucket1, bucket2);
+    join_result.compact(output_size);
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration_join_compact = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Join + Compact Time: " << duration_join_compact << " ms" << std::endl;
+    io->flush();
+
+    start_time = std::chrono::high_resolution_clock::now();
+
+    TiledEquiJoinOperator tiled(0, 0, output_size);
+    SecureRelation tiled_large = tiled.execute(bucket1, bucket2);
+
+    end_time = std::chrono::high_resolution_clock::now();
+    auto duration_tiled = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+    std::cout << "Tiled Join Time: " << duration_tiled << " ms" << std::endl;
+    io->flush();
+
+    delete io;
+    return 0;
+}
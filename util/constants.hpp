@@ -0,0 +1,56 @@
+// util/constants.hpp
+
+#ifndef CONSTANTS_HPP
+#define CONSTANTS_HPP
+
+#include "emp-sh2pc/emp-sh2pc.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Pool of public constants shared by all operators. Each constant is built once, on
+// first use after the protocol is set up, and copied from then on, so inner loops never
+// create wire labels, let alone feed a party input, for a value both parties know.
+// Public labels only depend on the global offset, which the worker sessions of a
+// SessionPool share with the main session, so the pool is valid in every thread.
+namespace Constants {
+
+    // Forward declarations
+    const emp::Bit& bit(bool value);
+    const emp::Integer& flag(bool value);
+    const emp::Integer& zero(int width = 32);
+
+    const int MAX_WIDTH = 64;
+
+    /* Implementations */
+
+    // Public 0 or 1 bit
+    const emp::Bit& bit(bool value) {
+        static const emp::Bit bits[2] = {emp::Bit(false, emp::PUBLIC), emp::Bit(true, emp::PUBLIC)};
+        return bits[value];
+    }
+
+    // 1-bit relation flag: dummy (false) or real (true)
+    const emp::Integer& flag(bool value) {
+        static const emp::Integer flags[2] = {emp::Integer(1, 0, emp::PUBLIC), emp::Integer(1, 1, emp::PUBLIC)};
+        return flags[value];
+    }
+
+    // Public zero of the given width, for widths 1 to MAX_WIDTH
+    const emp::Integer& zero(int width) {
+        if (width < 1 || width > MAX_WIDTH) {
+            throw std::invalid_argument("Constants::zero: width " + std::to_string(width) + " is outside 1.." + std::to_string(MAX_WIDTH));
+        }
+        static const std::vector<emp::Integer> zeros = [] {
+            std::vector<emp::Integer> result(1);
+            for (int w = 1; w <= MAX_WIDTH; w++) {
+                result.push_back(emp::Integer(w, 0, emp::PUBLIC));
+            }
+            return result;
+        }();
+        return zeros[width];
+    }
+
+} // namespace Constants
+
+#endif // CONSTANTS_HPP
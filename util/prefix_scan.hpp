@@ -0,0 +1,126 @@
+// util/prefix_scan.hpp
+
+#ifndef PREFIX_SCAN_HPP
+#define PREFIX_SCAN_HPP
+
+#include "emp-sh2pc/emp-sh2pc.h"
+#include <functional>
+#include <vector>
+
+#ifdef MULTI_THREAD
+#include "util/session_pool.hpp"
+#endif
+
+// Oblivious prefix scans over secret Integers with any associative operator, e.g. +, min,
+// max or "keep the left value". The scan is the Brent-Kung member of the Ladner-Fischer
+// family: an up-sweep and a down-sweep of log2(n) levels each, with at most 2n applications
+// of the operator in total, so it keeps the gate count of a sequential loop within a factor
+// of two while the depth drops from n to 2 log2(n). The applications within a level touch
+// disjoint rows, so every level can be split over the sessions of a pool.
+//
+// A segmented scan restarts at every row whose head bit is set: row i receives the operator
+// folded over the rows from the closest head at or before i, which is what per-group
+// aggregates, running counters per key and "carry the last marked row forward" need.
+namespace PrefixScan {
+
+    using Op = std::function<emp::Integer(const emp::Integer&, const emp::Integer&)>;
+
+    // Forward declarations
+    void inclusive_scan(std::vector<emp::Integer>& values, const Op& op);
+    void segmented_scan(std::vector<emp::Integer>& values, const std::vector<emp::Bit>& heads, const Op& op);
+#ifdef MULTI_THREAD
+    void inclusive_scan(std::vector<emp::Integer>& values, const Op& op, SessionPool* pool);
+    void segmented_scan(std::vector<emp::Integer>& values, const std::vector<emp::Bit>& heads, const Op& op, SessionPool* pool);
+#endif
+
+    // Common operators
+    emp::Integer add(const emp::Integer& a, const emp::Integer& b);
+    emp::Integer bit_or(const emp::Integer& a, const emp::Integer& b);
+    emp::Integer keep_left(const emp::Integer& a, const emp::Integer& b);
+
+    /* Implementations */
+
+    namespace detail {
+
+        // Runs task(begin, end) over [0, count), in a pool when one is given
+        using Runner = std::function<void(int, const std::function<void(int, int)>&)>;
+
+        // values[i] = values[i - step] (.) values[i] for i = first, first + 2 step, ...; with heads,
+        // (.) is the segmented operator: a right side that starts a segment is kept as it is
+        void level(std::vector<emp::Integer>& values, std::vector<emp::Bit>* heads, const Op& op, int first, int step, const Runner& runner) {
+            int n = values.size();
+            int count = first < n ? (n - 1 - first) / (2 * step) + 1 : 0;
+            runner(count, [&](int begin, int end) {
+                for (int k = begin; k < end; k++) {
+                    int i = first + k * 2 * step;
+                    emp::Integer combined = op(values[i - step], values[i]);
+                    if (heads != nullptr) {
+                        values[i] = emp::If((*heads)[i], values[i], combined);
+                        (*heads)[i] = (*heads)[i] | (*heads)[i - step];
+                    } else {
+                        values[i] = combined;
+                    }
+                }
+            });
+        }
+
+        void scan(std::vector<emp::Integer>& values, std::vector<emp::Bit>* heads, const Op& op, const Runner& runner) {
+            int n = values.size();
+            int step = 1;
+
+            // Up-sweep: row 2^(l+1) k - 1 receives the fold of its aligned block of 2^(l+1) rows
+            for (; 2 * step <= n; step *= 2) {
+                level(values, heads, op, 2 * step - 1, step, runner);
+            }
+
+            // Down-sweep: hand the block prefixes to the rows between the block ends
+            for (step /= 2; step >= 1; step /= 2) {
+                level(values, heads, op, 3 * step - 1, step, runner);
+            }
+        }
+
+        void serial(int count, const std::function<void(int, int)>& task) {
+            task(0, count);
+        }
+
+    } // namespace detail
+
+    void inclusive_scan(std::vector<emp::Integer>& values, const Op& op) {
+        detail::scan(values, nullptr, op, detail::serial);
+    }
+
+    void segmented_scan(std::vector<emp::Integer>& values, const std::vector<emp::Bit>& heads, const Op& op) {
+        std::vector<emp::Bit> segment_heads = heads;
+        detail::scan(values, &segment_heads, op, detail::serial);
+    }
+
+#ifdef MULTI_THREAD
+    void inclusive_scan(std::vector<emp::Integer>& values, const Op& op, SessionPool* pool) {
+        detail::scan(values, nullptr, op, [pool](int count, const std::function<void(int, int)>& task) {
+            pool->run_chunked(count, task);
+        });
+    }
+
+    void segmented_scan(std::vector<emp::Integer>& values, const std::vector<emp::Bit>& heads, const Op& op, SessionPool* pool) {
+        std::vector<emp::Bit> segment_heads = heads;
+        detail::scan(values, &segment_heads, op, [pool](int count, const std::function<void(int, int)>& task) {
+            pool->run_chunked(count, task);
+        });
+    }
+#endif
+
+    emp::Integer add(const emp::Integer& a, const emp::Integer& b) {
+        return a + b;
+    }
+
+    emp::Integer bit_or(const emp::Integer& a, const emp::Integer& b) {
+        return a | b;
+    }
+
+    emp::Integer keep_left(const emp::Integer& a, const emp::Integer& b) {
+        return a;
+    }
+
+} // namespace PrefixScan
+
+#endif // PREFIX_SCAN_HPP
@@ -0,0 +1,92 @@
+// util/public_compare.hpp
+
+#ifndef PUBLIC_COMPARE_HPP
+#define PUBLIC_COMPARE_HPP
+
+#include "emp-sh2pc/emp-sh2pc.h"
+#include "util/constants.hpp"
+#include <cstdint>
+#include <vector>
+
+// Comparison circuits between a secret signed Integer and a public constant.
+// The constant is known in the clear when the circuit is built, so every
+// XOR with it is free and the comparator chain is folded wherever the
+// running result is still a known constant.
+namespace PublicCompare {
+
+    // Forward declarations
+    bool out_of_range(int width, int64_t c, bool& above);
+    emp::Bit equal(const emp::Integer& x, int64_t c);
+    emp::Bit less_than(const emp::Integer& x, int64_t c, bool or_equal = false);
+
+    /* Implementations */
+
+    // True if c cannot be represented as a signed width-bit value; above tells on which side
+    bool out_of_range(int width, int64_t c, bool& above) {
+        if (width >= 64) return false;
+        int64_t min_val = -(int64_t(1) << (width - 1));
+        int64_t max_val = (int64_t(1) << (width - 1)) - 1;
+        above = c > max_val;
+        return c < min_val || c > max_val;
+    }
+
+    // x == c: one literal per bit (x_i or !x_i, chosen in the clear) reduced by a balanced AND tree
+    emp::Bit equal(const emp::Integer& x, int64_t c) {
+        int n = x.size();
+        bool above;
+        if (out_of_range(n, c, above)) return Constants::bit(false);
+
+        std::vector<emp::Bit> literals(n);
+        for (int i = 0; i < n; i++) {
+            literals[i] = ((c >> i) & 1) ? x[i] : !x[i];
+        }
+        while (literals.size() > 1) {
+            size_t half = literals.size() / 2;
+            for (size_t i = 0; i < half; i++) {
+                literals[i] = literals[2 * i] & literals[2 * i + 1];
+            }
+            if (literals.size() % 2 == 1) {
+                literals[half] = literals.back();
+                half++;
+            }
+            literals.resize(half);
+        }
+        return literals[0];
+    }
+
+    // x < c (x <= c when or_equal), signed. Both sides are biased by 2^(n-1) so the
+    // comparison becomes unsigned, then scanned from the LSB:
+    //     lt_i = c_i ? (!x_i | lt_{i-1}) : (!x_i & lt_{i-1})
+    // Each step costs one AND, except the low-order steps where lt is still a known
+    // constant, which are free. Those cover the trailing run of c that matches the
+    // initial value of lt, plus the bit that ends it.
+    emp::Bit less_than(const emp::Integer& x, int64_t c, bool or_equal) {
+        int n = x.size();
+        bool above;
+        if (out_of_range(n, c, above)) return Constants::bit(above);
+
+        uint64_t biased = static_cast<uint64_t>(c) ^ (uint64_t(1) << (n - 1));
+
+        bool known = true;          // lt is still a public constant
+        bool known_value = or_equal;
+        emp::Bit lt;
+        for (int i = 0; i < n; i++) {
+            bool c_bit = (biased >> i) & 1;
+            emp::Bit x_bit = (i == n - 1) ? !x[i] : x[i];
+
+            if (known) {
+                if (c_bit == known_value) continue;  // true | .. or false & .. keeps the constant
+                lt = !x_bit;
+                known = false;
+            } else if (c_bit) {
+                lt = !(x_bit & !lt);
+            } else {
+                lt = (!x_bit) & lt;
+            }
+        }
+        return known ? Constants::bit(known_value) : lt;
+    }
+
+} // namespace PublicCompare
+
+#endif // PUBLIC_COMPARE_HPP
@@ -0,0 +1,180 @@
+// util/session_pool.hpp
+
+#ifndef SESSION_POOL_HPP
+#define SESSION_POOL_HPP
+
+#include "emp-sh2pc/emp-sh2pc.h"
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifndef THREADING
+#error "SessionPool needs emp's thread-local execution contexts; configure with -DMULTI_THREAD=ON"
+#endif
+
+// A pool of paired ALICE/BOB channels, each carrying its own semi-honest session.
+// Sessions are opened once, in the same order by both parties, on consecutive ports.
+// A worker thread binds one session as its thread-local emp execution before it
+// evaluates any gate, so session i of ALICE always talks to session i of BOB.
+// ALICE's sessions reuse the global offset (delta) of the main session, which keeps
+// wire labels created on the main thread valid inside the workers. Setting the delta
+// sends a second pair of public-constant labels after the one the generator's constructor
+// sent, so BOB reads that pair too before the OT setup starts on the channel.
+class SessionPool {
+public:
+    SessionPool(int party, const char* address, int base_port, int num_sessions);
+    ~SessionPool();
+
+    int size() const { return sessions.size(); }
+
+    // Run task(i) for every session i, each on its own thread bound to session i
+    void run(const std::function<void(int)>& task);
+
+    // Split [0, n) into one contiguous chunk per session and run task(begin, end) on each
+    void run_chunked(int n, const std::function<void(int, int)>& task);
+
+    // Run task(t) for every t in [0, costs.size()) with work stealing. ALICE seeds one queue
+    // per session with the most expensive tasks first, balanced by cost; a session whose
+    // queue runs dry steals the cheapest task of the most loaded one. ALICE's worker sends
+    // every task id it picks over its own channel before running it, and BOB's worker on
+    // that channel runs exactly the ids it receives, so both parties agree on the mapping.
+    void run_scheduled(const std::vector<long long>& costs, const std::function<void(int)>& task);
+
+private:
+    struct Session {
+        emp::NetIO* io;
+        emp::CircuitExecution* circ_exec;
+        emp::ProtocolExecution* prot_exec;
+    };
+
+    int party;
+    std::vector<Session> sessions;
+
+    // Sent in place of a task id once a session has no work left
+    static const int NO_TASK = -1;
+};
+
+// Implementations
+
+SessionPool::SessionPool(int party, const char* address, int base_port, int num_sessions) : party(party) {
+    if (num_sessions <= 0) {
+        throw std::invalid_argument("SessionPool needs at least one session");
+    }
+
+    emp::block delta;
+    if (party == emp::ALICE) {
+        delta = ((emp::HalfGateGen<emp::NetIO>*)emp::CircuitExecution::circ_exec)->delta;
+    }
+
+    for (int i = 0; i < num_sessions; i++) {
+        Session session;
+        session.io = new emp::NetIO(party == emp::ALICE ? nullptr : address, base_port + i);
+        if (party == emp::ALICE) {
+            emp::HalfGateGen<emp::NetIO>* gen = new emp::HalfGateGen<emp::NetIO>(session.io);
+            gen->set_delta(delta);
+            session.circ_exec = gen;
+            session.prot_exec = new emp::SemiHonestGen<emp::NetIO>(session.io, gen);
+        } else {
+            emp::HalfGateEva<emp::NetIO>* eva = new emp::HalfGateEva<emp::NetIO>(session.io);
+            session.io->recv_block(eva->constant, 2);
+            session.circ_exec = eva;
+            session.prot_exec = new emp::SemiHonestEva<emp::NetIO>(session.io, eva);
+        }
+        sessions.push_back(session);
+    }
+}
+
+SessionPool::~SessionPool() {
+    for (auto& session : sessions) {
+        delete session.prot_exec;
+        delete session.circ_exec;
+        delete session.io;
+    }
+}
+
+void SessionPool::run(const std::function<void(int)>& task) {
+    std::vector<std::thread> threads;
+    for (int i = 0; i < sessions.size(); i++) {
+        threads.emplace_back([this, &task, i] {
+            emp::CircuitExecution::circ_exec = sessions[i].circ_exec;
+            emp::ProtocolExecution::prot_exec = sessions[i].prot_exec;
+            task(i);
+            sessions[i].io->flush();
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void SessionPool::run_chunked(int n, const std::function<void(int, int)>& task) {
+    int chunks = sessions.size();
+    run([n, chunks, &task](int i) {
+        int begin = static_cast<long long>(n) * i / chunks;
+        int end = static_cast<long long>(n) * (i + 1) / chunks;
+        task(begin, end);
+    });
+}
+
+void SessionPool::run_scheduled(const std::vector<long long>& costs, const std::function<void(int)>& task) {
+    if (party != emp::ALICE) {
+        run([this, &task](int i) {
+            int id;
+            sessions[i].io->recv_data(&id, sizeof(int));
+            while (id != NO_TASK) {
+                task(id);
+                sessions[i].io->recv_data(&id, sizeof(int));
+            }
+        });
+        return;
+    }
+
+    // Seed: most expensive tasks first, each to the least loaded session
+    std::vector<int> order(costs.size());
+    for (size_t t = 0; t < costs.size(); t++) order[t] = t;
+    std::stable_sort(order.begin(), order.end(), [&costs](int a, int b) { return costs[a] > costs[b]; });
+
+    std::vector<std::deque<int>> queues(sessions.size());
+    std::vector<long long> load(sessions.size(), 0);
+    for (int t : order) {
+        int target = std::min_element(load.begin(), load.end()) - load.begin();
+        queues[target].push_back(t);
+        load[target] += costs[t];
+    }
+
+    std::mutex queue_mutex;
+    auto next_task = [&](int i) {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        int victim = i;
+        if (queues[i].empty()) {
+            victim = -1;
+            for (size_t j = 0; j < queues.size(); j++) {
+                if (!queues[j].empty() && (victim < 0 || load[j] > load[victim])) victim = j;
+            }
+            if (victim < 0) return static_cast<int>(NO_TASK);
+        }
+        // Own queue from the front (largest first), stolen work from the back (smallest first)
+        int t = victim == i ? queues[i].front() : queues[victim].back();
+        if (victim == i) queues[i].pop_front(); else queues[victim].pop_back();
+        load[victim] -= costs[t];
+        return t;
+    };
+
+    run([this, &task, &next_task](int i) {
+        int id = next_task(i);
+        while (true) {
+            sessions[i].io->send_data(&id, sizeof(int));
+            sessions[i].io->flush();
+            if (id == NO_TASK) break;
+            task(id);
+            id = next_task(i);
+        }
+    });
+}
+
+#endif // SESSION_POOL_HPP